@@ -5,22 +5,16 @@ int main()
 {
     std::string pathL = "./images/left/image%02d.jpg";
     std::string pathR = "./images/right/image%02d.jpg";
-
-
-    Calibrator calibratorL(20, 9, 6);
-    calibratorL.reinitCaptureFieldWithImagesPath(pathL);
-    calibratorL.execute();
-    rename("intrinsic_matrix.yml", "intrinsic_matrixL.yml");
-    rename("distortion_coeffs.yml", "distortion_coeffsL.yml");
-    Calibrator calibratorR(20, 9, 6);
-    calibratorR.reinitCaptureFieldWithImagesPath(pathR);
-    calibratorR.execute();
-    rename("intrinsic_matrix.yml", "intrinsic_matrixR.yml");
-    rename("distortion_coeffs.yml", "distortion_coeffsR.yml");
+    std::string cornersCache = "./corners_cache.bin";
 
 
     StereoCalibrator scalibrator(pathL, pathR, 9, 6);
-    scalibrator.execute();
+    scalibrator.useCornersCache(cornersCache);
+    if(!scalibrator.executeEndToEnd())
+    {
+        std::cout << InterruptedByUser().what() << std::endl;
+        return 1;
+    }
 
     return 0;
 }
@@ -0,0 +1,90 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+
+#ifdef COUNT_ALLOCATIONS
+
+#include <cerrno>
+#include <cstddef>
+
+extern "C"
+{
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t amount, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+}
+
+static std::atomic<uint64_t> allocationsAmount(0);
+
+static void countAllocation() noexcept
+{
+    allocationsAmount.fetch_add(1, std::memory_order_relaxed);
+}
+
+extern "C"
+{
+void* malloc(size_t size) noexcept
+{
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t amount, size_t size) noexcept
+{
+    countAllocation();
+    return __libc_calloc(amount, size);
+}
+
+void* realloc(void* pointer, size_t size) noexcept
+{
+    countAllocation();
+    return __libc_realloc(pointer, size);
+}
+
+void* memalign(size_t alignment, size_t size) noexcept
+{
+    countAllocation();
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept
+{
+    countAllocation();
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** pointer, size_t alignment, size_t size) noexcept
+{
+    if(alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+        return EINVAL;
+
+    countAllocation();
+    *pointer = __libc_memalign(alignment, size);
+    return *pointer || size == 0 ? 0 : ENOMEM;
+}
+}
+
+bool AllocationCounter::isEnabled() noexcept
+{
+    return true;
+}
+
+uint64_t AllocationCounter::count() noexcept
+{
+    return allocationsAmount.load(std::memory_order_relaxed);
+}
+
+#else
+
+bool AllocationCounter::isEnabled() noexcept
+{
+    return false;
+}
+
+uint64_t AllocationCounter::count() noexcept
+{
+    return 0;
+}
+
+#endif
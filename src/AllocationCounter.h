@@ -0,0 +1,19 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <cstdint>
+
+/*
+ * Counts heap allocations made by the whole process. The counting hook
+ * replaces the malloc family (which OpenCV's fastMalloc and the default
+ * operator new both end in) and is only built with COUNT_ALLOCATIONS,
+ * so regular builds keep the system allocator untouched.
+ */
+class AllocationCounter
+{
+public:
+    static bool isEnabled() noexcept;
+    static uint64_t count() noexcept;
+};
+
+#endif // ALLOCATIONCOUNTER_H
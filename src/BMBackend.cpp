@@ -0,0 +1,55 @@
+#include "BMBackend.h"
+
+#include <algorithm>
+
+BMBackend::BMBackend() noexcept
+    : _stereoBMState(cv::StereoBM::BASIC_PRESET)
+{
+    _parameters.numberOfDisparities = 128;
+    _parameters.blockSize           = 21;
+    _parameters.preFilterCap        = 31;
+    _parameters.textureThreshold    = 10;
+    _parameters.uniquenessRatio     = 15;
+}
+
+void BMBackend::compute(const cv::Mat& leftImage,
+                        const cv::Mat& rightImage,
+                        cv::Mat& disparity) noexcept
+{
+    applyParameters(leftImage.size());
+    _stereoBMState(leftImage, rightImage, disparity, CV_16S);
+}
+
+void BMBackend::applyParameters(const cv::Size& imageSize) noexcept
+{
+    int maxBlockSize = std::min({MAX_BLOCK_SIZE,
+                                 imageSize.width,
+                                 imageSize.height});
+    int numberOfDisparities =
+        std::max(DISPARITIES_DIVISOR,
+                 _parameters.numberOfDisparities / DISPARITIES_DIVISOR *
+                 DISPARITIES_DIVISOR);
+
+    _stereoBMState.state->preFilterType       = CV_STEREO_BM_XSOBEL;
+    _stereoBMState.state->preFilterSize       =
+        oddInRange(_parameters.preFilterSize,
+                   MIN_PREFILTER_SIZE, MAX_PREFILTER_SIZE);
+    _stereoBMState.state->preFilterCap        =
+        std::max(MIN_PREFILTER_CAP,
+                 std::min(_parameters.preFilterCap, MAX_PREFILTER_CAP));
+    _stereoBMState.state->SADWindowSize       =
+        oddInRange(_parameters.blockSize, MIN_BLOCK_SIZE, maxBlockSize);
+    _stereoBMState.state->minDisparity        = _parameters.minDisparity;
+    _stereoBMState.state->numberOfDisparities = numberOfDisparities;
+    _stereoBMState.state->textureThreshold    = _parameters.textureThreshold;
+    _stereoBMState.state->uniquenessRatio     = _parameters.uniquenessRatio;
+    _stereoBMState.state->speckleWindowSize   = _parameters.speckleWindowSize;
+    _stereoBMState.state->speckleRange        = _parameters.speckleRange;
+    _stereoBMState.state->disp12MaxDiff       = _parameters.disp12MaxDiff;
+}
+
+int BMBackend::oddInRange(int value, int min, int max) const noexcept
+{
+    value = std::max(min, std::min(value, max));
+    return value % 2 ? value : value - 1;
+}
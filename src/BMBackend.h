@@ -0,0 +1,39 @@
+#ifndef BMBACKEND_H
+#define BMBACKEND_H
+
+#include "StereoMatcherBackend.h"
+
+#include <opencv2/calib3d/calib3d.hpp>
+
+class BMBackend : public StereoMatcherBackend
+{
+public:
+    BMBackend() noexcept;
+
+    void compute(const cv::Mat& leftImage,
+                 const cv::Mat& rightImage,
+                 cv::Mat& disparity) noexcept;
+
+    std::string name() const noexcept { return NAME; }
+
+private:
+    void applyParameters(const cv::Size& imageSize) noexcept;
+
+    int oddInRange(int value, int min, int max) const noexcept;
+
+
+
+    cv::StereoBM _stereoBMState;
+
+    const int MIN_BLOCK_SIZE       = 5;
+    const int MAX_BLOCK_SIZE       = 255;
+    const int MIN_PREFILTER_SIZE   = 5;
+    const int MAX_PREFILTER_SIZE   = 255;
+    const int MIN_PREFILTER_CAP    = 1;
+    const int MAX_PREFILTER_CAP    = 63;
+    const int DISPARITIES_DIVISOR  = 16;
+
+    const std::string NAME = "BM";
+};
+
+#endif // BMBACKEND_H
@@ -0,0 +1,263 @@
+#include "BatchDisparityProcessor.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+#include <dirent.h>
+#include <sys/stat.h>
+
+BatchDisparityProcessor::BatchDisparityProcessor(
+        const RectifyMaps& rectifyMaps,
+        const std::string& outputDirectory) noexcept
+    : _leftUndistorter(rectifyMaps.leftX, rectifyMaps.leftY),
+      _rightUndistorter(rectifyMaps.rightX, rectifyMaps.rightY),
+      _outputDirectory(outputDirectory),
+      _processedPairs(0)
+{
+    loadMatcherParameters();
+}
+
+BatchDisparityProcessor::BatchDisparityProcessor(
+        const std::string& pathToRectifyMaps,
+        const std::string& outputDirectory) noexcept
+    : _outputDirectory(outputDirectory),
+      _processedPairs(0)
+{
+    RectifyMaps rectifyMaps;
+    cv::FileStorage fileStorage(pathToRectifyMaps, cv::FileStorage::READ);
+    fileStorage[RECTIFY_MAP_X1_TITLE] >> rectifyMaps.leftX;
+    fileStorage[RECTIFY_MAP_Y1_TITLE] >> rectifyMaps.leftY;
+    fileStorage[RECTIFY_MAP_X2_TITLE] >> rectifyMaps.rightX;
+    fileStorage[RECTIFY_MAP_Y2_TITLE] >> rectifyMaps.rightY;
+    fileStorage.release();
+
+    _leftUndistorter  = Undistorter(rectifyMaps.leftX, rectifyMaps.leftY);
+    _rightUndistorter = Undistorter(rectifyMaps.rightX, rectifyMaps.rightY);
+    loadMatcherParameters();
+}
+
+int BatchDisparityProcessor::process(const ImagePairs& imagePairs) noexcept
+{
+    _inputDirectory = commonDirectory(imagePairs);
+    vector<int> pairs = pendingPairs(imagePairs);
+    int openCVThreads = cv::getNumThreads();
+
+    std::cout << "Pairs to process: " << pairs.size() << " of "
+              << imagePairs.size() << std::endl;
+    mkdir(_outputDirectory.c_str(), 0755);
+    for(int pair : pairs)
+        createOutputDirectories(outputPath(imagePairs[pair].first));
+    distributePairs(pairs);
+    _processedPairs = 0;
+
+    cv::setNumThreads(1);
+    vector<std::thread> workers;
+    for(int worker = 0; worker < _workersAmount; worker++)
+        workers.push_back(std::thread(&BatchDisparityProcessor::runWorker,
+                                      this, worker, std::cref(imagePairs)));
+    for(auto& worker : workers)
+        worker.join();
+    cv::setNumThreads(openCVThreads);
+
+    std::cout << "Processed pairs: " << _processedPairs << std::endl;
+    return _processedPairs;
+}
+
+int BatchDisparityProcessor::processDirectories(
+        const std::string& leftDirectory,
+        const std::string& rightDirectory) noexcept
+{
+    return process(listImagePairs(leftDirectory, rightDirectory));
+}
+
+void BatchDisparityProcessor::setParameters(
+        const StereoMatcherParameters& parameters) noexcept
+{
+    _parameters = parameters;
+}
+
+void BatchDisparityProcessor::setWorkersAmount(int workersAmount) noexcept
+{
+    _workersAmount = std::max(workersAmount, 1);
+}
+
+ImagePairs BatchDisparityProcessor::listImagePairs(
+        const std::string& leftDirectory,
+        const std::string& rightDirectory) noexcept
+{
+    vector<std::string> names;
+    ImagePairs imagePairs;
+    DIR* directory = opendir(leftDirectory.c_str());
+    if(!directory) return imagePairs;
+
+    while(dirent* entry = readdir(directory))
+        if(entry->d_name[0] != '.') names.push_back(entry->d_name);
+    closedir(directory);
+    std::sort(names.begin(), names.end());
+
+    struct stat fileStatus;
+    for(auto& name : names)
+    {
+        std::string rightImage = rightDirectory + "/" + name;
+        if(stat(rightImage.c_str(), &fileStatus) == 0 &&
+           S_ISREG(fileStatus.st_mode))
+            imagePairs.push_back(std::make_pair(leftDirectory + "/" + name,
+                                                rightImage));
+    }
+    return imagePairs;
+}
+
+void BatchDisparityProcessor::loadMatcherParameters() noexcept
+{
+    cv::FileStorage fileStorage(MATCHER_PARAMETERS_FILE,
+                                cv::FileStorage::READ);
+    if(!fileStorage.isOpened()) return;
+
+    SGBMBackend backend;
+    backend.loadParameters(fileStorage);
+    _parameters = backend.parameters();
+    fileStorage.release();
+}
+
+vector<int> BatchDisparityProcessor::pendingPairs(const ImagePairs& imagePairs)
+    const noexcept
+{
+    vector<int> pairs;
+    struct stat fileStatus;
+
+    for(size_t pair = 0; pair < imagePairs.size(); pair++)
+        if(stat(outputPath(imagePairs[pair].first).c_str(), &fileStatus) != 0)
+            pairs.push_back(pair);
+    return pairs;
+}
+
+void BatchDisparityProcessor::distributePairs(const vector<int>& pairs)
+    noexcept
+{
+    _queues.reset(new BatchWorkQueue[_workersAmount]);
+
+    size_t chunkSize = (pairs.size() + _workersAmount - 1) / _workersAmount;
+    for(size_t i = 0; i < pairs.size(); i++)
+        _queues[i / chunkSize].pairs.push_back(pairs[i]);
+}
+
+bool BatchDisparityProcessor::takePair(int worker, int& pair) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(_queues[worker].mutex);
+        if(!_queues[worker].pairs.empty())
+        {
+            pair = _queues[worker].pairs.front();
+            _queues[worker].pairs.pop_front();
+            return true;
+        }
+    }
+
+    for(int offset = 1; offset < _workersAmount; offset++)
+    {
+        BatchWorkQueue& victim = _queues[(worker + offset) % _workersAmount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if(!victim.pairs.empty())
+        {
+            pair = victim.pairs.back();
+            victim.pairs.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void BatchDisparityProcessor::runWorker(int worker,
+                                        const ImagePairs& imagePairs) noexcept
+{
+    SGBMBackend backend;
+    BatchWorkerBuffers buffers;
+    int pair;
+
+    backend.parameters() = _parameters;
+    while(takePair(worker, pair))
+        if(processPair(imagePairs[pair], backend, buffers))
+            _processedPairs++;
+        else
+            std::cerr << "Failed to process " << imagePairs[pair].first
+                      << std::endl;
+}
+
+bool BatchDisparityProcessor::processPair(
+        const std::pair<std::string, std::string>& imagePair,
+        SGBMBackend& backend,
+        BatchWorkerBuffers& buffers) const noexcept
+{
+    cv::Mat leftImage  = cv::imread(imagePair.first, CV_LOAD_IMAGE_GRAYSCALE);
+    cv::Mat rightImage = cv::imread(imagePair.second, CV_LOAD_IMAGE_GRAYSCALE);
+    if(leftImage.empty() || rightImage.empty()) return false;
+
+    _leftUndistorter.apply(leftImage, buffers.leftRectified);
+    _rightUndistorter.apply(rightImage, buffers.rightRectified);
+    backend.compute(buffers.leftRectified,
+                    buffers.rightRectified,
+                    buffers.disparity);
+
+    return saveDisparityMap(buffers.disparity,
+                            outputPath(imagePair.first),
+                            buffers.encodedDisparity);
+}
+
+bool BatchDisparityProcessor::saveDisparityMap(
+        const cv::Mat& disparity,
+        const std::string& path,
+        vector<uchar>& encodedDisparity) const noexcept
+{
+    cv::Mat unsignedView(disparity.size(), CV_16UC1,
+                         disparity.data, disparity.step);
+    vector<int> parameters = {CV_IMWRITE_PNG_COMPRESSION, PNG_COMPRESSION_LEVEL};
+    if(!cv::imencode(OUTPUT_EXTENSION, unsignedView, encodedDisparity,
+                     parameters))
+        return false;
+
+    std::string partialPath = path + PARTIAL_OUTPUT_EXTENSION;
+    std::ofstream output(partialPath, std::ofstream::binary);
+    output.write(reinterpret_cast<const char*>(encodedDisparity.data()),
+                 encodedDisparity.size());
+    output.close();
+    if(!output) return false;
+
+    return std::rename(partialPath.c_str(), path.c_str()) == 0;
+}
+
+std::string BatchDisparityProcessor::outputPath(const std::string& leftImage)
+    const noexcept
+{
+    return _outputDirectory + "/" +
+           leftImage.substr(_inputDirectory.size()) + OUTPUT_SUFFIX;
+}
+
+void BatchDisparityProcessor::createOutputDirectories(const std::string& path)
+    const noexcept
+{
+    size_t separator = _outputDirectory.size() + 1;
+    while((separator = path.find('/', separator)) != std::string::npos)
+        mkdir(path.substr(0, separator++).c_str(), 0755);
+}
+
+std::string BatchDisparityProcessor::commonDirectory(
+        const ImagePairs& imagePairs) noexcept
+{
+    if(imagePairs.empty()) return std::string();
+
+    std::string directory = imagePairs.front().first;
+    for(auto& imagePair : imagePairs)
+    {
+        size_t length = 0;
+        const std::string& leftImage = imagePair.first;
+        while(length < directory.size() && length < leftImage.size() &&
+              directory[length] == leftImage[length])
+            length++;
+        directory.resize(length);
+    }
+
+    size_t separator = directory.find_last_of('/');
+    return separator == std::string::npos ? std::string()
+                                          : directory.substr(0, separator + 1);
+}
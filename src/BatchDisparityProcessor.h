@@ -0,0 +1,106 @@
+#ifndef BATCHDISPARITYPROCESSOR_H
+#define BATCHDISPARITYPROCESSOR_H
+
+#include "SGBMBackend.h"
+#include "Undistorter.h"
+#include "RectifyMapGenerator.h"
+#include "StereoMatcherParameters.h"
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/highgui/highgui.hpp>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <utility>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+
+using std::vector;
+using ImagePairs = vector<std::pair<std::string, std::string>>;
+
+struct BatchWorkQueue
+{
+    std::mutex mutex;
+    std::deque<int> pairs;
+};
+
+struct BatchWorkerBuffers
+{
+    cv::Mat leftRectified;
+    cv::Mat rightRectified;
+    cv::Mat disparity;
+    vector<uchar> encodedDisparity;
+};
+
+class BatchDisparityProcessor
+{
+public:
+    BatchDisparityProcessor(const RectifyMaps& rectifyMaps,
+                            const std::string& outputDirectory) noexcept;
+    BatchDisparityProcessor(const std::string& pathToRectifyMaps,
+                            const std::string& outputDirectory) noexcept;
+
+    int process(const ImagePairs& imagePairs) noexcept;
+    int processDirectories(const std::string& leftDirectory,
+                           const std::string& rightDirectory) noexcept;
+
+    void setParameters(const StereoMatcherParameters& parameters) noexcept;
+    void setWorkersAmount(int workersAmount) noexcept;
+
+    static ImagePairs listImagePairs(const std::string& leftDirectory,
+                                     const std::string& rightDirectory)
+        noexcept;
+
+private:
+    void loadMatcherParameters() noexcept;
+
+    vector<int> pendingPairs(const ImagePairs& imagePairs) const noexcept;
+    void distributePairs(const vector<int>& pairs) noexcept;
+    bool takePair(int worker, int& pair) noexcept;
+
+    void runWorker(int worker, const ImagePairs& imagePairs) noexcept;
+    bool processPair(const std::pair<std::string, std::string>& imagePair,
+                     SGBMBackend& backend,
+                     BatchWorkerBuffers& buffers) const noexcept;
+    bool saveDisparityMap(const cv::Mat& disparity,
+                          const std::string& path,
+                          vector<uchar>& encodedDisparity) const noexcept;
+
+    std::string outputPath(const std::string& leftImage) const noexcept;
+    void createOutputDirectories(const std::string& path) const noexcept;
+
+    static std::string commonDirectory(const ImagePairs& imagePairs)
+        noexcept;
+
+
+
+    Undistorter _leftUndistorter;
+    Undistorter _rightUndistorter;
+    StereoMatcherParameters _parameters;
+
+    std::string _outputDirectory;
+    std::string _inputDirectory;
+    int _workersAmount =
+        std::max<int>(std::thread::hardware_concurrency(), 1);
+
+    std::unique_ptr<BatchWorkQueue[]> _queues;
+    std::atomic<int> _processedPairs;
+
+    const int PNG_COMPRESSION_LEVEL = 1;
+
+    const std::string OUTPUT_EXTENSION = ".png";
+    const std::string OUTPUT_SUFFIX = ".disparity" + OUTPUT_EXTENSION;
+    const std::string PARTIAL_OUTPUT_EXTENSION = ".part";
+    const std::string MATCHER_PARAMETERS_FILE = "matcher_parameters.yml";
+
+    const std::string RECTIFY_MAP_X1_TITLE  = "Rectify Map X1";
+    const std::string RECTIFY_MAP_Y1_TITLE  = "Rectify Map Y1";
+    const std::string RECTIFY_MAP_X2_TITLE  = "Rectify Map X2";
+    const std::string RECTIFY_MAP_Y2_TITLE  = "Rectify Map Y2";
+};
+
+#endif // BATCHDISPARITYPROCESSOR_H
@@ -26,6 +26,15 @@ void CalibrationData::saveDistortionCoeffsWithYmlExtension(
     fileStorage.release();
 }
 
+void CalibrationData::saveKeptViewsWithYmlExtension(const std::string &path)
+        const noexcept
+{
+    cv::FileStorage fileStorage(path, cv::FileStorage::WRITE);
+    fileStorage << KEPT_VIEWS_TITLE << _keptViews;
+    fileStorage << PER_VIEW_ERRORS_TITLE << _perViewErrors;
+    fileStorage.release();
+}
+
 void CalibrationData::loadIntrinsicMatrix(const std::string &path, int index)
         noexcept
 {
@@ -6,6 +6,13 @@
 
 using std::vector;
 
+enum class CalibrationPattern
+{
+    CHESSBOARD,
+    ASYMMETRIC_CIRCLES_GRID,
+    CHARUCO
+};
+
 class CalibrationData
 {
 public:
@@ -44,10 +51,21 @@ public:
     void setTranslation(const vector<cv::Mat> &translation) noexcept
     { _translation = translation; }
 
+    const vector<int>& keptViews() const noexcept { return _keptViews; }
+    const vector<double>& perViewErrors() const noexcept
+    { return _perViewErrors; }
+
+    void setKeptViews(const vector<int>& keptViews) noexcept
+    { _keptViews = keptViews; }
+    void setPerViewErrors(const vector<double>& perViewErrors) noexcept
+    { _perViewErrors = perViewErrors; }
+
     void saveIntrinsicMatrixWithYmlExtension(const std::string &path, int index)
         const noexcept;
     void saveDistortionCoeffsWithYmlExtension(const std::string &path, int index)
         const noexcept;
+    void saveKeptViewsWithYmlExtension(const std::string &path)
+        const noexcept;
     void loadIntrinsicMatrix(const std::string &path, int index) noexcept;
     void loadDistortionCoeffs(const std::string &path, int index) noexcept;
 
@@ -64,10 +82,15 @@ protected:
 
     const std::string INTRINSIC_MATRIX_TITLE = "Intrinsic Matrix";
     const std::string DISTORTION_COEFFS_TITLE = "Distortion Coefficients";
+    const std::string KEPT_VIEWS_TITLE = "Kept Views";
+    const std::string PER_VIEW_ERRORS_TITLE = "Per View Errors";
 
 private:
     vector<cv::Mat> _rotation;
     vector<cv::Mat> _translation;
+
+    vector<int> _keptViews;
+    vector<double> _perViewErrors;
 };
 
 #endif //CALIBRATIONDATA_H_
@@ -1,64 +1,240 @@
 #include "Calibrator.h"
 #include "DisplayManager.h"
 
+#ifdef HAVE_OPENCV_ARUCO
+#include <opencv2/aruco/charuco.hpp>
+#endif
+
 Calibrator::Calibrator(int imagesAmount, int boardWidth, int boardHeight)
     noexcept
     : _calibrationData(imagesAmount, boardWidth, boardHeight)
 {
 }
 
-void Calibrator::execute() noexcept
+bool Calibrator::execute() noexcept
 {
-    _image = nextImage(_capture);
+    try{ _image = nextImage(_capture); }
+    catch(ImageReadError)
+    {
+        std::cout << NO_IMAGES << std::endl;
+        return false;
+    }
 
-    DisplayManager::createWindows(
-        {CALIBRATION_WINDOW_NAME, UNDISTORTED_WINDOW_NAME});
-    findAllCorners();
+    if(!_headless)
+        DisplayManager::createWindows(
+            {CALIBRATION_WINDOW_NAME, UNDISTORTED_WINDOW_NAME});
+    try{ findAllCorners(); }
+    catch(InterruptedByUser)
+    {
+        if(!_headless) DisplayManager::destroyAllWindows();
+        return false;
+    }
+    if(!hasEnoughViews())
+    {
+        if(!_headless) DisplayManager::destroyAllWindows();
+        return false;
+    }
 
-    calibrateCamera();
+    calibrateCamera(_image -> size());
 
-    _calibrationData.saveIntrinsicMatrixWithYmlExtension(
-            INTRINSIC_MATRIX_OUTPUT_FILE, 0);
-    _calibrationData.saveDistortionCoeffsWithYmlExtension(
-            DISTORTION_COEFFS_OUTPUT_FILE, 0);
+    saveSingleCalibrationResults(INTRINSIC_MATRIX_OUTPUT_FILE,
+                                 DISTORTION_COEFFS_OUTPUT_FILE,
+                                 KEPT_VIEWS_OUTPUT_FILE);
+
+    if(_headless) return true;
 
     reinitCaptureIfNecessary();
     if(_showUndistorted) presentImagesWithTheirsUndistortedCopy();
-    cv::destroyAllWindows();
+    DisplayManager::destroyAllWindows();
+    return true;
+}
+
+void Calibrator::calibrateFromCorners(const CornerStore& imagePoints,
+                                      const cv::Size& imageSize) noexcept
+{
+    _imagePoints = imagePoints;
+    _objectPoints.clear();
+    _objectPoints.reserve(_imagePoints.viewsAmount(),
+                          _calibrationData.pointsOnBoardAmount());
+    for(size_t view = 0; view < _imagePoints.viewsAmount(); view++)
+        _objectPoints.addView(boardPoints(_calibrationData));
+    _successes = _imagePoints.viewsAmount();
+
+    calibrateCamera(imageSize);
+}
+
+void Calibrator::saveSingleCalibrationResults(
+        const std::string& intrinsicPath,
+        const std::string& distortionPath,
+        const std::string& keptViewsPath) const noexcept
+{
+    _calibrationData.saveIntrinsicMatrixWithYmlExtension(intrinsicPath, 0);
+    _calibrationData.saveDistortionCoeffsWithYmlExtension(distortionPath, 0);
+    _calibrationData.saveKeptViewsWithYmlExtension(keptViewsPath);
 }
 
-void Calibrator::calibrateCamera() noexcept
+void Calibrator::calibrateCamera(const cv::Size& imageSize) noexcept
 {
     vector<cv::Mat> rotation, translation;
     cv::Mat intrinsic(3, 3, CV_32FC1), distortion(5, 1, CV_32FC1);
+    vector<double> perViewErrors;
+    vector<int> keptViews(_imagePoints.viewsAmount());
+    double error = 0;
 
     intrinsic.at<float>(0,0) = 1.0f;
     intrinsic.at<float>(1,1) = 1.0f;
+    for(size_t i = 0; i < keptViews.size(); i++) keptViews[i] = i;
 
-    double error = cv::calibrateCamera(_objectPoints,
-                                       _imagePoints,
-                                       _image -> size(),
-                                       intrinsic,
-                                       distortion,
-                                       rotation,
-                                       translation);
+    for(int iteration = 0; ; iteration++)
+    {
+        error = cv::calibrateCamera(_objectPoints.views(),
+                                    _imagePoints.views(),
+                                    imageSize,
+                                    intrinsic,
+                                    distortion,
+                                    rotation,
+                                    translation,
+                                    iteration ? CV_CALIB_USE_INTRINSIC_GUESS
+                                              : 0);
+        computePerViewErrors(intrinsic, distortion, rotation, translation,
+                             perViewErrors);
+        if(iteration == MAX_PRUNING_ITERATIONS ||
+           !pruneOutlierViews(perViewErrors, keptViews))
+            break;
+    }
     showCalibrationError(error);
 
     _calibrationData.addIntrinsic(intrinsic);
     _calibrationData.addDistortion(distortion);
     _calibrationData.setRotation(rotation);
     _calibrationData.setTranslation(translation);
+    _calibrationData.setKeptViews(keptViews);
+    _calibrationData.setPerViewErrors(perViewErrors);
+}
+
+class PerViewErrorComputer : public cv::ParallelLoopBody
+{
+public:
+    PerViewErrorComputer(const ObjectPointStore& objectPoints,
+                         const CornerStore& imagePoints,
+                         const cv::Mat& intrinsic,
+                         const cv::Mat& distortion,
+                         const vector<cv::Mat>& rotation,
+                         const vector<cv::Mat>& translation,
+                         vector<double>& perViewErrors) noexcept
+        : _objectPoints(objectPoints),
+          _imagePoints(imagePoints),
+          _intrinsic(intrinsic),
+          _distortion(distortion),
+          _rotation(rotation),
+          _translation(translation),
+          _perViewErrors(perViewErrors)
+    {
+    }
+
+    void operator()(const cv::Range& views) const
+    {
+        vector<cv::Point2f> projectedPoints;
+
+        for(int view = views.start; view < views.end; view++)
+        {
+            cv::projectPoints(_objectPoints.view(view),
+                              _rotation[view],
+                              _translation[view],
+                              _intrinsic,
+                              _distortion,
+                              projectedPoints);
+
+            double error = cv::norm(_imagePoints.view(view),
+                                    projectedPoints,
+                                    cv::NORM_L2);
+            _perViewErrors[view] =
+                std::sqrt(error * error / projectedPoints.size());
+        }
+    }
+
+private:
+    const ObjectPointStore& _objectPoints;
+    const CornerStore& _imagePoints;
+    const cv::Mat& _intrinsic;
+    const cv::Mat& _distortion;
+    const vector<cv::Mat>& _rotation;
+    const vector<cv::Mat>& _translation;
+    vector<double>& _perViewErrors;
+};
+
+void Calibrator::computePerViewErrors(const cv::Mat& intrinsic,
+                                      const cv::Mat& distortion,
+                                      const vector<cv::Mat>& rotation,
+                                      const vector<cv::Mat>& translation,
+                                      vector<double>& perViewErrors)
+    const noexcept
+{
+    perViewErrors.resize(_imagePoints.viewsAmount());
+    cv::parallel_for_(cv::Range(0, _imagePoints.viewsAmount()),
+                      PerViewErrorComputer(_objectPoints,
+                                           _imagePoints,
+                                           intrinsic,
+                                           distortion,
+                                           rotation,
+                                           translation,
+                                           perViewErrors));
+}
+
+double Calibrator::outlierThreshold(vector<double> perViewErrors)
+    const noexcept
+{
+    auto middle = perViewErrors.begin() + perViewErrors.size() / 2;
+
+    std::nth_element(perViewErrors.begin(), middle, perViewErrors.end());
+    double median = *middle;
+
+    for(auto& error : perViewErrors) error = std::abs(error - median);
+    std::nth_element(perViewErrors.begin(), middle, perViewErrors.end());
+    double medianAbsoluteDeviation = *middle;
+
+    return std::max(median + OUTLIER_MAD_FACTOR * MAD_TO_SIGMA *
+                             medianAbsoluteDeviation,
+                    MIN_OUTLIER_ERROR);
+}
+
+bool Calibrator::pruneOutlierViews(const vector<double>& perViewErrors,
+                                   vector<int>& keptViews) noexcept
+{
+    double threshold = outlierThreshold(perViewErrors);
+    size_t keptAmount = std::count_if(perViewErrors.begin(),
+                                      perViewErrors.end(),
+                                      [=](double error)
+                                      { return error <= threshold; });
+
+    if(keptAmount == perViewErrors.size() ||
+       keptAmount < static_cast<size_t>(MIN_VIEWS_AMOUNT))
+        return false;
+
+    vector<int> views;
+    for(size_t view = 0; view < perViewErrors.size(); view++)
+    {
+        if(perViewErrors[view] > threshold) continue;
+        keptViews[views.size()] = keptViews[view];
+        views.push_back(view);
+    }
+    std::cout << "Pruned views: " << perViewErrors.size() - keptAmount
+              << std::endl;
+    _imagePoints.keepViews(views);
+    _objectPoints.keepViews(views);
+    keptViews.resize(keptAmount);
+    return true;
 }
 
 char Calibrator::handlePause() const noexcept
 {
-    char pressedKey = cv::waitKey(WAITING_TIME);
+    char pressedKey = DisplayManager::pollKey();
 
     if(pressedKey == PAUSE_KEY)
     {
         pressedKey = 0;
         while(pressedKey != PAUSE_KEY && pressedKey != ESCAPE_KEY)
-            pressedKey = cv::waitKey(PAUSE_TIME);
+            pressedKey = DisplayManager::waitKey(PAUSE_TIME);
     }
     return pressedKey;
 }
@@ -66,19 +242,31 @@ char Calibrator::handlePause() const noexcept
 void Calibrator::handleEscInterruption(char pressedKey)
     const throw (InterruptedByUser)
 {
-    if(pressedKey == ESCAPE_KEY) throw InterruptedByUser();
+    if(pressedKey != ESCAPE_KEY) return;
+
+    if(_cornersCache) _cornersCache->save();
+    throw InterruptedByUser();
+}
+
+void Calibrator::checkInterruptionCallback() const throw (InterruptedByUser)
+{
+    if(!_interruptionCallback || !_interruptionCallback()) return;
+
+    if(_cornersCache) _cornersCache->save();
+    throw InterruptedByUser();
 }
 
 void Calibrator::reinitCaptureIfNecessary() noexcept
 {
     if(_needReinitCapture)
-        _capture = cv::VideoCapture(_captureSource);
+        _capture = FrameSource(_captureSource);
 }
 
 void Calibrator::presentImagesWithTheirsUndistortedCopy()
 {
     char pressedKey = 0;
 
+    _undistorter = Undistorter(_calibrationData, 0, _image->size());
     while(pressedKey != ESCAPE_KEY)
     {
         try{ _image = nextImage(_capture); }
@@ -88,8 +276,7 @@ void Calibrator::presentImagesWithTheirsUndistortedCopy()
     }
 }
 
-void Calibrator::showImageAndItsUndistortedCopy()
-    const noexcept
+void Calibrator::showImageAndItsUndistortedCopy() noexcept
 {
     MatSharedPtr undistortedImage = createUndistortedImage();
     DisplayManager::showImages(
@@ -97,19 +284,13 @@ void Calibrator::showImageAndItsUndistortedCopy()
                 std::make_tuple(UNDISTORTED_WINDOW_NAME, undistortedImage, 1)});
 }
 
-MatSharedPtr Calibrator::createUndistortedImage() const noexcept
+MatSharedPtr Calibrator::createUndistortedImage() noexcept
 {
-    MatSharedPtr undistortedImage =
-        MatSharedPtr(new cv::Mat(_image -> clone()));
-
-    cv::undistort(*_image,
-                  *undistortedImage,
-                  _calibrationData.intrinsic(0),
-                  _calibrationData.distortion(0));
-    return undistortedImage;
+    _undistorter.apply(*_image, *_undistortedImage);
+    return _undistortedImage;
 }
 
-MatSharedPtr Calibrator::nextImage(cv::VideoCapture& capture)
+MatSharedPtr Calibrator::nextImage(FrameSource& capture)
     const throw (ImageReadError)
 {
     MatSharedPtr image = MatSharedPtr(new cv::Mat());
@@ -119,10 +300,34 @@ MatSharedPtr Calibrator::nextImage(cv::VideoCapture& capture)
     return image;
 }
 
+MatSharedPtr Calibrator::nextSampledImage(FrameSource& capture,
+                                          int framesSkip)
+    const throw (ImageReadError)
+{
+    int framesToDrop = framesSkip - 1;
+
+    if(framesToDrop < MIN_FRAMES_TO_SEEK || !seekForward(capture, framesToDrop))
+        for(int i = 0; i < framesToDrop; i++)
+            if(!capture.grab())
+                throw ImageReadError();
+    return nextImage(capture);
+}
+
+bool Calibrator::seekForward(FrameSource& capture, int framesAmount)
+    const noexcept
+{
+    double position = capture.get(CV_CAP_PROP_POS_FRAMES);
+    double framesCount = capture.get(CV_CAP_PROP_FRAME_COUNT);
+
+    if(position < 0 || framesCount <= 0 || position + framesAmount >= framesCount)
+        return false;
+    return capture.set(CV_CAP_PROP_POS_FRAMES, position + framesAmount);
+}
+
 void Calibrator::reinitCaptureFieldWithImagesPath(const std::string &path)
     noexcept
 {
-    _capture = cv::VideoCapture(path);
+    _capture = FrameSource(path);
     _captureSource = path;
     _framesSkip = 1;
     _needReinitCapture = true;
@@ -131,7 +336,7 @@ void Calibrator::reinitCaptureFieldWithImagesPath(const std::string &path)
 void Calibrator::showChessboardPointsWhenFound(
                                     const CalibrationData& calibrationData)
 {
-    const bool isPatternFound = true;
+    const bool isPatternFound = _pattern != CalibrationPattern::CHARUCO;
 
     drawChessboardCorners(*_image,
                           calibrationData.boardSize(),
@@ -155,23 +360,85 @@ void Calibrator::showChessboardPointsWhenNotFound(
 }
 
 
-bool Calibrator::findCornersOnChessboard(const CalibrationData& calibrationData)
-    noexcept
+bool Calibrator::findCornersOnChessboard(const cv::Mat& image,
+                                         const cv::Size& boardSize,
+                                         vector<cv::Point2f>& corners)
+    const noexcept
 {
-    return findChessboardCorners(*_image,
-                                 calibrationData.boardSize(),
-                                 _corners,
-                                 cv::CALIB_CB_ADAPTIVE_THRESH |
-                                 cv::CALIB_CB_FILTER_QUADS);
+    return findChessboardCorners(image,
+                                 boardSize,
+                                 corners,
+                                 CHESSBOARD_DETECTION_FLAGS);
 }
 
-void Calibrator::getSubpixelAccuracy() noexcept
+bool Calibrator::findCirclesOnGrid(const cv::Mat& image,
+                                   const cv::Size& boardSize,
+                                   vector<cv::Point2f>& centers)
+    const noexcept
+{
+    return cv::findCirclesGrid(image,
+                               boardSize,
+                               centers,
+                               CIRCLES_GRID_DETECTION_FLAGS);
+}
+
+bool Calibrator::findCornersOnCharucoBoard(const cv::Mat& image,
+                                           const cv::Size& boardSize,
+                                           cv::Mat& grayImage,
+                                           vector<cv::Point2f>& corners,
+                                           vector<int>& ids) const noexcept
+{
+    corners.clear();
+    ids.clear();
+#ifdef HAVE_OPENCV_ARUCO
+    cv::Ptr<cv::aruco::Dictionary> dictionary =
+        cv::aruco::getPredefinedDictionary(cv::aruco::DICT_4X4_250);
+    cv::Ptr<cv::aruco::CharucoBoard> board =
+        cv::aruco::CharucoBoard::create(boardSize.width + 1,
+                                        boardSize.height + 1,
+                                        _squareSize,
+                                        _squareSize * CHARUCO_MARKER_RATIO,
+                                        dictionary);
+    vector<vector<cv::Point2f>> markerCorners;
+    vector<int> markerIds;
+
+    cv::cvtColor(image, grayImage, CV_BGR2GRAY);
+    cv::aruco::detectMarkers(grayImage, dictionary, markerCorners, markerIds);
+    if(markerIds.empty()) return false;
+
+    cv::aruco::interpolateCornersCharuco(markerCorners, markerIds, grayImage,
+                                         board, corners, ids);
+
+    vector<size_t> order(ids.size());
+    for(size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(),
+              [&](size_t a, size_t b) { return ids[a] < ids[b]; });
+
+    vector<cv::Point2f> sortedCorners(corners.size());
+    vector<int> sortedIds(ids.size());
+    for(size_t i = 0; i < order.size(); i++)
+    {
+        sortedCorners[i] = corners[order[i]];
+        sortedIds[i] = ids[order[i]];
+    }
+    corners.swap(sortedCorners);
+    ids.swap(sortedIds);
+    return static_cast<int>(ids.size()) >= MIN_CHARUCO_CORNERS;
+#else
+    return false;
+#endif
+}
+
+void Calibrator::getSubpixelAccuracy(const cv::Mat& image,
+                                     cv::Mat& grayImage,
+                                     vector<cv::Point2f>& corners)
+    const noexcept
 {
     cv::TermCriteria termCriteria(CV_TERMCRIT_EPS + CV_TERMCRIT_ITER, 30, 0.1);
 
-    cv::cvtColor(*_image, *_grayImage, CV_BGR2GRAY);
-    cv::cornerSubPix(*_grayImage,
-                     _corners,
+    cv::cvtColor(image, grayImage, CV_BGR2GRAY);
+    cv::cornerSubPix(grayImage,
+                     corners,
                      cv::Size(11,11),
                      cv::Size(-1,-1),
                      termCriteria);
@@ -179,34 +446,155 @@ void Calibrator::getSubpixelAccuracy() noexcept
 
 void Calibrator::saveImagePoints(
         const CalibrationData& calibrationData,
-        vector<vector<cv::Point2f>>& imagePoints) noexcept
+        CornerStore& imagePoints) noexcept
 {
-    imagePoints.push_back(_corners);
-    if(_objectPoints.size() < calibrationData.imagesAmount())
+    imagePoints.addView(_corners);
+    if(_pattern == CalibrationPattern::CHARUCO)
+        _objectPoints.addView(boardPoints(calibrationData, _cornerIds));
+    else if(_objectPoints.viewsAmount() < calibrationData.imagesAmount())
+        _objectPoints.addView(boardPoints(calibrationData));
+}
+
+vector<cv::Point3f> Calibrator::createBoardPoints(
+        const CalibrationData& calibrationData) const noexcept
+{
+    vector<cv::Point3f> boardPoints(calibrationData.pointsOnBoardAmount());
+    for(size_t i = 0; i < calibrationData.pointsOnBoardAmount(); i++)
     {
-        vector<cv::Point3f> boardPoints(calibrationData.pointsOnBoardAmount());
-        for(size_t i = 0; i < calibrationData.pointsOnBoardAmount(); i++)
-        {
-            boardPoints[i] = cv::Point3f(
-                        (i / calibrationData.boardWidth()) * _squareSize,
-                        (i % calibrationData.boardWidth()) * _squareSize, 0);
-        }
-        _objectPoints.push_back(boardPoints);
+        int row = i / calibrationData.boardWidth();
+        int column = i % calibrationData.boardWidth();
+
+        if(_pattern == CalibrationPattern::ASYMMETRIC_CIRCLES_GRID)
+            boardPoints[i] = cv::Point3f((2 * column + row % 2) * _squareSize,
+                                         row * _squareSize, 0);
+        else if(_pattern == CalibrationPattern::CHARUCO)
+            boardPoints[i] = cv::Point3f(column * _squareSize,
+                                         row * _squareSize, 0);
+        else
+            boardPoints[i] = cv::Point3f(row * _squareSize,
+                                         column * _squareSize, 0);
     }
+    return boardPoints;
+}
+
+vector<cv::Point3f> Calibrator::boardPoints(
+        const CalibrationData& calibrationData,
+        const vector<int>& ids) noexcept
+{
+    const vector<cv::Point3f>& allPoints = boardPoints(calibrationData);
+    vector<cv::Point3f> points;
+
+    points.reserve(ids.size());
+    for(int id : ids)
+        if(id >= 0 && id < static_cast<int>(allPoints.size()))
+            points.push_back(allPoints[id]);
+    return points;
+}
+
+bool Calibrator::isViewUsable(const CalibrationData& calibrationData)
+    const noexcept
+{
+    if(_pattern == CalibrationPattern::CHARUCO)
+        return static_cast<int>(_cornerIds.size()) >= MIN_CHARUCO_CORNERS &&
+               _cornerIds.size() == _corners.size();
+    return _corners.size() == calibrationData.pointsOnBoardAmount();
+}
+
+const vector<cv::Point3f>& Calibrator::boardPoints(
+        const CalibrationData& calibrationData) noexcept
+{
+    if(_boardPoints.size() != calibrationData.pointsOnBoardAmount())
+        _boardPoints = createBoardPoints(calibrationData);
+    return _boardPoints;
+}
+
+bool Calibrator::detectCorners(const CalibrationData& calibrationData) noexcept
+{
+    return detectCorners(*_image,
+                         calibrationData.boardSize(),
+                         *_grayImage,
+                         _corners,
+                         _cornerIds);
+}
+
+bool Calibrator::detectCorners(const cv::Mat& image,
+                               const cv::Size& boardSize,
+                               cv::Mat& grayImage,
+                               vector<cv::Point2f>& corners) const noexcept
+{
+    vector<int> ids;
+
+    return detectCorners(image, boardSize, grayImage, corners, ids) &&
+           static_cast<int>(corners.size()) == boardSize.area();
+}
+
+bool Calibrator::detectCorners(const cv::Mat& image,
+                               const cv::Size& boardSize,
+                               cv::Mat& grayImage,
+                               vector<cv::Point2f>& corners,
+                               vector<int>& ids) const noexcept
+{
+    uint64_t cacheKey = 0;
+
+    if(_pattern == CalibrationPattern::CHARUCO)
+        return findCornersOnCharucoBoard(image, boardSize, grayImage,
+                                         corners, ids);
+
+    ids.clear();
+    if(_cornersCache)
+    {
+        cacheKey = CornersCache::key(image, boardSize, detectionFlags());
+        if(_cornersCache->find(cacheKey, corners))
+            return static_cast<int>(corners.size()) == boardSize.area();
+    }
+
+    bool isPatternFound = detectPattern(image, boardSize, grayImage, corners);
+
+    if(_cornersCache)
+        _cornersCache->insert(cacheKey,
+                              isPatternFound ? corners
+                                             : vector<cv::Point2f>());
+    return isPatternFound;
+}
+
+bool Calibrator::detectPattern(const cv::Mat& image,
+                               const cv::Size& boardSize,
+                               cv::Mat& grayImage,
+                               vector<cv::Point2f>& corners) const noexcept
+{
+    if(_pattern == CalibrationPattern::ASYMMETRIC_CIRCLES_GRID)
+        return findCirclesOnGrid(image, boardSize, corners);
+
+    bool isPatternFound = findCornersOnChessboard(image, boardSize, corners);
+    if(isPatternFound) getSubpixelAccuracy(image, grayImage, corners);
+    return isPatternFound;
+}
+
+int Calibrator::detectionFlags() const noexcept
+{
+    if(_pattern == CalibrationPattern::ASYMMETRIC_CIRCLES_GRID)
+        return CIRCLES_GRID_DETECTION_FLAGS;
+    return CHESSBOARD_DETECTION_FLAGS;
+}
+
+void Calibrator::saveCornersCache() noexcept
+{
+    if(_cornersCache) _cornersCache->save();
 }
 
 void Calibrator::findCornersOnImage(
         const CalibrationData& calibrationData,
-        vector<vector<cv::Point2f>>& imagePoints) noexcept
+        CornerStore& imagePoints) noexcept
 {
-    if(findCornersOnChessboard(calibrationData))
+    if(detectCorners(calibrationData))
     {
-        getSubpixelAccuracy();
-        if(_displayCorners) showChessboardPointsWhenFound(calibrationData);
+        if(shouldDisplayCorners())
+            showChessboardPointsWhenFound(calibrationData);
     }
-    else if(_displayCorners) showChessboardPointsWhenNotFound(calibrationData);
+    else if(shouldDisplayCorners())
+        showChessboardPointsWhenNotFound(calibrationData);
 
-    if(_corners.size() == calibrationData.pointsOnBoardAmount())
+    if(isViewUsable(calibrationData))
     {
         saveImagePoints(calibrationData, imagePoints);
         _successes++;
@@ -218,32 +606,58 @@ MatSharedPtr Calibrator::createGrayImage() noexcept
     return MatSharedPtr(new cv::Mat(_image -> size(), CV_8UC1));
 }
 
-void Calibrator::displayNumberOfSuccesses() noexcept
+bool Calibrator::shouldDisplayCorners() const noexcept
 {
-    std::cout << "Successes: " << _successes << std::endl;
+    return _displayCorners && !_headless;
 }
 
-void Calibrator::findAllCorners() noexcept
+void Calibrator::reportProgress(int done, int total) const noexcept
 {
-    int frame = 0;
+    if(_progressCallback)
+        _progressCallback(done, total);
+    else
+        std::cout << "Successes: " << done << std::endl;
+}
 
+void Calibrator::findAllCorners() throw (InterruptedByUser)
+{
+    _imagePoints.reserve(_calibrationData.imagesAmount(),
+                         _calibrationData.pointsOnBoardAmount());
+    _objectPoints.reserve(_calibrationData.imagesAmount(),
+                          _calibrationData.pointsOnBoardAmount());
     _grayImage = createGrayImage();
     while(_successes < _calibrationData.imagesAmount())
     {
-        DisplayManager::showImages(
-            {std::make_tuple(CALIBRATION_WINDOW_NAME, _image, SHOWING_TIME)});
-        if(frame++ % _framesSkip == 0)
+        if(!_headless)
+            DisplayManager::showImages(
+                {std::make_tuple(CALIBRATION_WINDOW_NAME,
+                                 _image,
+                                 SHOWING_TIME)});
+        findCornersOnImage(_calibrationData,
+                           _imagePoints);
+        reportProgress(_successes, _calibrationData.imagesAmount());
+
+        if(!_headless) handleEscInterruption(handlePause());
+        checkInterruptionCallback();
+        if(_successes >= _calibrationData.imagesAmount()) break;
+
+        try{ _image = nextSampledImage(_capture, _framesSkip); }
+        catch(ImageReadError)
         {
-            findCornersOnImage(_calibrationData,
-                               _imagePoints);
-            displayNumberOfSuccesses();
+            std::cout << END_OF_STREAM << _successes << std::endl;
+            break;
         }
-
-        char pressedKey = handlePause();
-        handleEscInterruption(pressedKey);
-        if(_successes < _calibrationData.imagesAmount())
-            _image = nextImage(_capture);
     }
+    saveCornersCache();
+}
+
+bool Calibrator::hasEnoughViews() const noexcept
+{
+    if(static_cast<int>(_imagePoints.viewsAmount()) >= MIN_VIEWS_AMOUNT)
+        return true;
+
+    std::cout << NOT_ENOUGH_VIEWS << std::endl;
+    return false;
 }
 
 void Calibrator::setDisplayCorners(bool displayCorners) noexcept
@@ -259,6 +673,45 @@ void Calibrator::setShowUndistorted(bool showUndistorted) noexcept
 void Calibrator::setSquareSize(double squareSize) noexcept
 {
     _squareSize = squareSize;
+    _boardPoints.clear();
+}
+
+void Calibrator::setPattern(CalibrationPattern pattern)
+    throw (UnsupportedPatternError)
+{
+#ifndef HAVE_OPENCV_ARUCO
+    if(pattern == CalibrationPattern::CHARUCO)
+        throw UnsupportedPatternError();
+#endif
+    _pattern = pattern;
+    _boardPoints.clear();
+}
+
+void Calibrator::useCornersCache(const std::string& path) noexcept
+{
+    _cornersCache = std::make_shared<CornersCache>(path);
+}
+
+void Calibrator::useCornersCache(
+        const std::shared_ptr<CornersCache>& cornersCache) noexcept
+{
+    _cornersCache = cornersCache;
+}
+
+void Calibrator::setHeadless(bool headless) noexcept
+{
+    _headless = headless;
+}
+
+void Calibrator::setProgressCallback(const ProgressCallback& callback) noexcept
+{
+    _progressCallback = callback;
+}
+
+void Calibrator::setInterruptionCallback(const InterruptionCallback& callback)
+    noexcept
+{
+    _interruptionCallback = callback;
 }
 
 void Calibrator::showCalibrationError(double error) const noexcept
@@ -3,6 +3,10 @@
 
 #include "CommonExceptions.h"
 #include "CalibrationData.h"
+#include "CornersCache.h"
+#include "Undistorter.h"
+#include "PointStore.h"
+#include "FrameSource.h"
 
 #include <opencv2/highgui/highgui.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
@@ -11,17 +15,31 @@
 #include <utility>
 #include <initializer_list>
 #include <memory>
+#include <functional>
+#include <algorithm>
+#include <cmath>
 
 using std::vector;
 
 using MatSharedPtr = std::shared_ptr<cv::Mat>;
+using ProgressCallback = std::function<void(int done, int total)>;
+using InterruptionCallback = std::function<bool()>;
 
 class Calibrator
 {
 public:
     Calibrator(int imagesAmount, int boardWidth, int boardHeight) noexcept;
 
-    void execute() noexcept;
+    bool execute() noexcept;
+    void calibrateFromCorners(const CornerStore& imagePoints,
+                              const cv::Size& imageSize) noexcept;
+    void saveSingleCalibrationResults(const std::string& intrinsicPath,
+                                      const std::string& distortionPath,
+                                      const std::string& keptViewsPath)
+        const noexcept;
+
+    const CalibrationData& calibrationData() const noexcept
+    { return _calibrationData; }
 
     void reinitCaptureFieldWithImagesPath(const std::string &path) noexcept;
 
@@ -29,49 +47,136 @@ public:
     void setShowUndistorted(bool showUndistorted) noexcept;
 
     void setSquareSize(double squareSize) noexcept;
+    void setPattern(CalibrationPattern pattern)
+        throw (UnsupportedPatternError);
+
+    void setHeadless(bool headless) noexcept;
+    void setProgressCallback(const ProgressCallback& callback) noexcept;
+    void setInterruptionCallback(const InterruptionCallback& callback)
+        noexcept;
+
+    void useCornersCache(const std::string& path) noexcept;
+    void useCornersCache(const std::shared_ptr<CornersCache>& cornersCache)
+        noexcept;
 
 protected:
     Calibrator() noexcept {}
 
-    MatSharedPtr nextImage(cv::VideoCapture& capture)
+    MatSharedPtr nextImage(FrameSource& capture)
         const throw (ImageReadError);
+    MatSharedPtr nextSampledImage(FrameSource& capture, int framesSkip)
+        const throw (ImageReadError);
+    bool seekForward(FrameSource& capture, int framesAmount)
+        const noexcept;
 
     MatSharedPtr createGrayImage() noexcept;
-    void getSubpixelAccuracy() noexcept;
+    bool findCornersOnChessboard(const cv::Mat& image,
+                                 const cv::Size& boardSize,
+                                 vector<cv::Point2f>& corners) const noexcept;
+    bool findCirclesOnGrid(const cv::Mat& image,
+                           const cv::Size& boardSize,
+                           vector<cv::Point2f>& centers) const noexcept;
+    bool findCornersOnCharucoBoard(const cv::Mat& image,
+                                   const cv::Size& boardSize,
+                                   cv::Mat& grayImage,
+                                   vector<cv::Point2f>& corners,
+                                   vector<int>& ids) const noexcept;
+    void getSubpixelAccuracy(const cv::Mat& image,
+                             cv::Mat& grayImage,
+                             vector<cv::Point2f>& corners) const noexcept;
+
+    bool detectCorners(const CalibrationData& calibrationData) noexcept;
+    bool detectCorners(const cv::Mat& image,
+                       const cv::Size& boardSize,
+                       cv::Mat& grayImage,
+                       vector<cv::Point2f>& corners) const noexcept;
+    bool detectCorners(const cv::Mat& image,
+                       const cv::Size& boardSize,
+                       cv::Mat& grayImage,
+                       vector<cv::Point2f>& corners,
+                       vector<int>& ids) const noexcept;
+    bool detectPattern(const cv::Mat& image,
+                       const cv::Size& boardSize,
+                       cv::Mat& grayImage,
+                       vector<cv::Point2f>& corners) const noexcept;
+    int detectionFlags() const noexcept;
+    void saveCornersCache() noexcept;
 
     void findCornersOnImage(const CalibrationData& calibrationData,
-                            vector<vector<cv::Point2f>>& imagePoints) noexcept;
+                            CornerStore& imagePoints) noexcept;
+
+    vector<cv::Point3f> createBoardPoints(
+            const CalibrationData& calibrationData) const noexcept;
+    const vector<cv::Point3f>& boardPoints(
+            const CalibrationData& calibrationData) noexcept;
+    vector<cv::Point3f> boardPoints(const CalibrationData& calibrationData,
+                                    const vector<int>& ids) noexcept;
+    bool isViewUsable(const CalibrationData& calibrationData) const noexcept;
 
     void showCalibrationError(double error) const noexcept;
 
+    bool shouldDisplayCorners() const noexcept;
+    void reportProgress(int done, int total) const noexcept;
+    void checkInterruptionCallback() const throw (InterruptedByUser);
+
 
 
     MatSharedPtr _image = nullptr;
     MatSharedPtr _grayImage;
+    MatSharedPtr _undistortedImage = std::make_shared<cv::Mat>();
+    Undistorter _undistorter;
     vector<cv::Point2f> _corners;
-    vector<vector<cv::Point3f>> _objectPoints;
+    vector<int> _cornerIds;
+    ObjectPointStore _objectPoints;
+    vector<cv::Point3f> _boardPoints;
 
     bool _displayCorners = true;
     bool _showUndistorted = true;
+    bool _headless = false;
 
     double _squareSize = 1;
+    CalibrationPattern _pattern = CalibrationPattern::CHESSBOARD;
+
+    ProgressCallback _progressCallback = nullptr;
+    InterruptionCallback _interruptionCallback = nullptr;
+
+    std::shared_ptr<CornersCache> _cornersCache = nullptr;
+
+    const int CHESSBOARD_DETECTION_FLAGS = cv::CALIB_CB_ADAPTIVE_THRESH |
+                                           cv::CALIB_CB_FILTER_QUADS;
+    const int CIRCLES_GRID_DETECTION_FLAGS = cv::CALIB_CB_ASYMMETRIC_GRID;
+    const int MIN_CHARUCO_CORNERS = 8;
+    const float CHARUCO_MARKER_RATIO = 0.7f;
+    const int MIN_VIEWS_AMOUNT = 3;
+
+    char handlePause() const noexcept;
+
+    const char PAUSE_KEY  = 'p';
+    const char ESCAPE_KEY = 27;
+    const int  PAUSE_TIME = 250;
 
 private:
     void reinitCaptureIfNecessary() noexcept;
 
     void presentImagesWithTheirsUndistortedCopy();
-    void showImageAndItsUndistortedCopy() const noexcept;
+    void showImageAndItsUndistortedCopy() noexcept;
 
-    MatSharedPtr createUndistortedImage() const noexcept;
+    MatSharedPtr createUndistortedImage() noexcept;
 
-    char handlePause() const noexcept;
     void handleEscInterruption(char pressedKey) const throw (InterruptedByUser);
 
-    void calibrateCamera() noexcept;
+    void calibrateCamera(const cv::Size& imageSize) noexcept;
+    void computePerViewErrors(const cv::Mat& intrinsic,
+                              const cv::Mat& distortion,
+                              const vector<cv::Mat>& rotation,
+                              const vector<cv::Mat>& translation,
+                              vector<double>& perViewErrors) const noexcept;
+    double outlierThreshold(vector<double> perViewErrors) const noexcept;
+    bool pruneOutlierViews(const vector<double>& perViewErrors,
+                           vector<int>& keptViews) noexcept;
 
-    void findAllCorners() noexcept;
-    bool findCornersOnChessboard(const CalibrationData& calibrationData)
-        noexcept;
+    void findAllCorners() throw (InterruptedByUser);
+    bool hasEnoughViews() const noexcept;
 
     void showChessboardPointsWhenFound(
             const CalibrationData& calibrationData);
@@ -79,33 +184,39 @@ private:
             const CalibrationData &calibrationData);
 
     void saveImagePoints(const CalibrationData& calibrationData,
-                         vector<vector<cv::Point2f>>& imagePoints) noexcept;
-
-    void displayNumberOfSuccesses() noexcept;
+                         CornerStore& imagePoints) noexcept;
 
 
 
-    cv::VideoCapture _capture;
+    FrameSource _capture;
     std::string _captureSource = "";
     CalibrationData  _calibrationData;
 
-    vector<vector<cv::Point2f>> _imagePoints;
+    CornerStore _imagePoints;
 
     int _successes = 0;
     int _framesSkip = 20;
 
+    const int MIN_FRAMES_TO_SEEK = 30;
+
     bool _needReinitCapture = false;
 
     const std::string CALIBRATION_WINDOW_NAME = "Calibration";
     const std::string UNDISTORTED_WINDOW_NAME = "Undistort";
     const std::string INTRINSIC_MATRIX_OUTPUT_FILE = "intrinsic_matrix.yml";
     const std::string DISTORTION_COEFFS_OUTPUT_FILE = "distortion_coeffs.yml";
+    const std::string KEPT_VIEWS_OUTPUT_FILE = "kept_views.yml";
+
+    const std::string NO_IMAGES = "No images to calibrate from";
+    const std::string END_OF_STREAM = "End of image stream, successes: ";
+    const std::string NOT_ENOUGH_VIEWS = "Not enough views to calibrate";
 
-    const char PAUSE_KEY    = 'p';
-    const char ESCAPE_KEY   = 27;
-    const int  PAUSE_TIME   = 250;
-    const int  WAITING_TIME = 50;
     const int  SHOWING_TIME = 1;
+
+    const int    MAX_PRUNING_ITERATIONS = 5;
+    const double MIN_OUTLIER_ERROR      = 0.5;
+    const double OUTLIER_MAD_FACTOR     = 3.0;
+    const double MAD_TO_SIGMA           = 1.4826;
 };
 
 
@@ -0,0 +1,122 @@
+#include "CensusBackend.h"
+
+class CensusTransformer : public cv::ParallelLoopBody
+{
+public:
+    CensusTransformer(const cv::Mat& image, cv::Mat& census) noexcept
+        : _image(image), _census(census)
+    {
+    }
+
+    void operator()(const cv::Range& rows) const
+    {
+        for(int y = rows.start; y < rows.end; y++)
+            CensusMatcher<16>::censusTransformRow(_image.ptr<uint8_t>(),
+                                                  _image.step,
+                                                  _image.cols,
+                                                  _image.rows,
+                                                  y,
+                                                  _census.ptr<uint32_t>(y));
+    }
+
+private:
+    const cv::Mat& _image;
+    cv::Mat& _census;
+};
+
+CensusBackend::CensusBackend() noexcept
+{
+    _parameters.numberOfDisparities = 128;
+    _parameters.uniquenessRatio     = 10;
+    _parameters.smoothnessPar1      = 8;
+    _parameters.smoothnessPar2      = 96;
+}
+
+void CensusBackend::compute(const cv::Mat& leftImage,
+                            const cv::Mat& rightImage,
+                            cv::Mat& disparity) noexcept
+{
+    computeDisparity(leftImage, rightImage, disparity, nullptr);
+}
+
+void CensusBackend::computeWithUniqueness(const cv::Mat& leftImage,
+                                          const cv::Mat& rightImage,
+                                          cv::Mat& disparity,
+                                          cv::Mat& uniqueness) noexcept
+{
+    computeDisparity(leftImage, rightImage, disparity, &uniqueness);
+}
+
+bool CensusBackend::clampParameters() noexcept
+{
+    if(_parameters.numberOfDisparities <= MAX_NUMBER_OF_DISPARITIES)
+        return false;
+
+    _parameters.numberOfDisparities = MAX_NUMBER_OF_DISPARITIES;
+    std::cout << DISPARITIES_CLAMPED << MAX_NUMBER_OF_DISPARITIES
+              << std::endl;
+    return true;
+}
+
+void CensusBackend::computeDisparity(const cv::Mat& leftImage,
+                                     const cv::Mat& rightImage,
+                                     cv::Mat& disparity,
+                                     cv::Mat* uniqueness) noexcept
+{
+    clampParameters();
+    computeCensus(leftImage, _leftCensus);
+    computeCensus(rightImage, _rightCensus);
+    disparity.create(leftImage.size(), CV_16S);
+    if(uniqueness) uniqueness->create(leftImage.size(), CV_8U);
+
+    if(_parameters.numberOfDisparities <= 64)
+        computeWithMatcher(_matcher64, disparity, uniqueness);
+    else if(_parameters.numberOfDisparities <= 128)
+        computeWithMatcher(_matcher128, disparity, uniqueness);
+    else
+        computeWithMatcher(_matcher256, disparity, uniqueness);
+
+    filterSpeckles(disparity);
+}
+
+void CensusBackend::computeCensus(const cv::Mat& image, cv::Mat& census)
+    const noexcept
+{
+    census.create(image.size(), CV_32S);
+    cv::parallel_for_(cv::Range(0, image.rows),
+                      CensusTransformer(image, census));
+}
+
+template<int DISPARITIES>
+void CensusBackend::computeWithMatcher(CensusMatcher<DISPARITIES>& matcher,
+                                       cv::Mat& disparity,
+                                       cv::Mat* uniqueness) noexcept
+{
+    matcher.setParameters(_parameters.minDisparity,
+                          _parameters.numberOfDisparities,
+                          _parameters.smoothnessPar1,
+                          _parameters.smoothnessPar2,
+                          _parameters.uniquenessRatio);
+    matcher.compute(_leftCensus.ptr<uint32_t>(),
+                    _rightCensus.ptr<uint32_t>(),
+                    _leftCensus.step / sizeof(uint32_t),
+                    _leftCensus.cols,
+                    _leftCensus.rows,
+                    disparity.ptr<int16_t>(),
+                    disparity.step / sizeof(int16_t),
+                    uniqueness ? uniqueness->ptr<uint8_t>() : nullptr,
+                    uniqueness ? uniqueness->step : 0);
+}
+
+void CensusBackend::filterSpeckles(cv::Mat& disparity) noexcept
+{
+    if(_parameters.speckleWindowSize <= 0) return;
+
+    cv::filterSpeckles(disparity,
+                       (_parameters.minDisparity - 1) *
+                       CensusMatcher<16>::DISPARITY_SCALE,
+                       _parameters.speckleWindowSize,
+                       _parameters.speckleRange *
+                       CensusMatcher<16>::DISPARITY_SCALE,
+                       _speckleBuffer);
+}
@@ -0,0 +1,59 @@
+#ifndef CENSUSBACKEND_H
+#define CENSUSBACKEND_H
+
+#include "StereoMatcherBackend.h"
+#include "CensusMatcher.h"
+
+#include <opencv2/calib3d/calib3d.hpp>
+
+#include <iostream>
+
+class CensusBackend : public StereoMatcherBackend
+{
+public:
+    CensusBackend() noexcept;
+
+    void compute(const cv::Mat& leftImage,
+                 const cv::Mat& rightImage,
+                 cv::Mat& disparity) noexcept;
+    void computeWithUniqueness(const cv::Mat& leftImage,
+                               const cv::Mat& rightImage,
+                               cv::Mat& disparity,
+                               cv::Mat& uniqueness) noexcept;
+
+    std::string name() const noexcept { return NAME; }
+
+    bool clampParameters() noexcept;
+
+private:
+    void computeDisparity(const cv::Mat& leftImage,
+                          const cv::Mat& rightImage,
+                          cv::Mat& disparity,
+                          cv::Mat* uniqueness) noexcept;
+    void computeCensus(const cv::Mat& image, cv::Mat& census) const noexcept;
+
+    template<int DISPARITIES>
+    void computeWithMatcher(CensusMatcher<DISPARITIES>& matcher,
+                            cv::Mat& disparity,
+                            cv::Mat* uniqueness) noexcept;
+
+    void filterSpeckles(cv::Mat& disparity) noexcept;
+
+
+
+    cv::Mat _leftCensus;
+    cv::Mat _rightCensus;
+    cv::Mat _speckleBuffer;
+
+    CensusMatcher<64>  _matcher64;
+    CensusMatcher<128> _matcher128;
+    CensusMatcher<256> _matcher256;
+
+    const int MAX_NUMBER_OF_DISPARITIES = 256;
+
+    const std::string NAME = "Census";
+    const std::string DISPARITIES_CLAMPED =
+        "Census: number of disparities clamped to ";
+};
+
+#endif // CENSUSBACKEND_H
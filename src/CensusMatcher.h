@@ -0,0 +1,479 @@
+#ifndef CENSUSMATCHER_H
+#define CENSUSMATCHER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__AVX2__)
+struct CensusVectorOps
+{
+    using Vector = __m256i;
+    static const int LANES = 16;
+
+    static Vector load(const uint16_t* data)
+    { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)); }
+    static void store(uint16_t* data, Vector value)
+    { _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), value); }
+    static Vector set(uint16_t value)
+    { return _mm256_set1_epi16(static_cast<short>(value)); }
+    static Vector adds(Vector first, Vector second)
+    { return _mm256_adds_epu16(first, second); }
+    static Vector subtract(Vector first, Vector second)
+    { return _mm256_sub_epi16(first, second); }
+    static Vector min(Vector first, Vector second)
+    { return _mm256_min_epi16(first, second); }
+
+    static uint16_t horizontalMin(Vector value)
+    {
+        __m128i half = _mm_min_epi16(_mm256_castsi256_si128(value),
+                                     _mm256_extracti128_si256(value, 1));
+        half = _mm_min_epi16(half, _mm_srli_si128(half, 8));
+        half = _mm_min_epi16(half, _mm_srli_si128(half, 4));
+        half = _mm_min_epi16(half, _mm_srli_si128(half, 2));
+        return static_cast<uint16_t>(_mm_extract_epi16(half, 0));
+    }
+};
+#elif defined(__SSE2__)
+struct CensusVectorOps
+{
+    using Vector = __m128i;
+    static const int LANES = 8;
+
+    static Vector load(const uint16_t* data)
+    { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)); }
+    static void store(uint16_t* data, Vector value)
+    { _mm_storeu_si128(reinterpret_cast<__m128i*>(data), value); }
+    static Vector set(uint16_t value)
+    { return _mm_set1_epi16(static_cast<short>(value)); }
+    static Vector adds(Vector first, Vector second)
+    { return _mm_adds_epu16(first, second); }
+    static Vector subtract(Vector first, Vector second)
+    { return _mm_sub_epi16(first, second); }
+    static Vector min(Vector first, Vector second)
+    { return _mm_min_epi16(first, second); }
+
+    static uint16_t horizontalMin(Vector value)
+    {
+        value = _mm_min_epi16(value, _mm_srli_si128(value, 8));
+        value = _mm_min_epi16(value, _mm_srli_si128(value, 4));
+        value = _mm_min_epi16(value, _mm_srli_si128(value, 2));
+        return static_cast<uint16_t>(_mm_extract_epi16(value, 0));
+    }
+};
+#else
+struct CensusVectorOps
+{
+    using Vector = uint16_t;
+    static const int LANES = 1;
+
+    static Vector load(const uint16_t* data) { return *data; }
+    static void store(uint16_t* data, Vector value) { *data = value; }
+    static Vector set(uint16_t value) { return value; }
+    static Vector adds(Vector first, Vector second)
+    { return std::min<unsigned>(first + second, 0xFFFF); }
+    static Vector subtract(Vector first, Vector second)
+    { return first - second; }
+    static Vector min(Vector first, Vector second)
+    { return std::min(first, second); }
+    static uint16_t horizontalMin(Vector value) { return value; }
+};
+#endif
+
+template<int DISPARITIES>
+class CensusMatcher
+{
+    static_assert(DISPARITIES % 16 == 0,
+                  "Disparities amount has to be a multiple of 16");
+
+public:
+    static const int DISPARITY_SCALE = 16;
+    static const int CENSUS_RADIUS   = 2;
+
+    void setParameters(int minDisparity,
+                       int activeDisparities,
+                       int smoothnessPar1,
+                       int smoothnessPar2,
+                       int uniquenessRatio) noexcept
+    {
+        _minDisparity      = minDisparity;
+        _activeDisparities = std::max(1, std::min(activeDisparities,
+                                                  DISPARITIES));
+        _smoothnessPar1    = std::max(0, std::min(smoothnessPar1,
+                                                  MAX_PENALTY));
+        _smoothnessPar2    = std::max(_smoothnessPar1,
+                                      std::min(smoothnessPar2, MAX_PENALTY));
+        _uniquenessRatio   = uniquenessRatio;
+    }
+
+    int16_t invalidDisparity() const noexcept
+    { return (_minDisparity - 1) * DISPARITY_SCALE; }
+
+    static void censusTransformRow(const uint8_t* image,
+                                   size_t stride,
+                                   int width,
+                                   int height,
+                                   int y,
+                                   uint32_t* census) noexcept
+    {
+        std::fill(census, census + width, 0);
+        if(y < CENSUS_RADIUS || y >= height - CENSUS_RADIUS) return;
+
+        for(int x = CENSUS_RADIUS; x < width - CENSUS_RADIUS; x++)
+        {
+            uint8_t center = image[y * stride + x];
+            uint32_t value = 0;
+
+            for(int dy = -CENSUS_RADIUS; dy <= CENSUS_RADIUS; dy++)
+                for(int dx = -CENSUS_RADIUS; dx <= CENSUS_RADIUS; dx++)
+                    if(dx || dy)
+                        value = (value << 1) |
+                                (image[(y + dy) * stride + x + dx] < center);
+            census[x] = value;
+        }
+    }
+
+    void compute(const uint32_t* leftCensus,
+                 const uint32_t* rightCensus,
+                 size_t censusStride,
+                 int width,
+                 int height,
+                 int16_t* disparity,
+                 size_t disparityStride,
+                 uint8_t* uniqueness = nullptr,
+                 size_t uniquenessStride = 0) noexcept
+    {
+        allocateBuffers(width);
+
+        for(int y = 0; y < height; y++)
+        {
+            reverseRow(rightCensus + y * censusStride, width);
+            computeRowCosts(leftCensus + y * censusStride, width);
+            aggregateForwardPaths(width);
+            aggregateBackwardPathAndSelect(
+                width, disparity + y * disparityStride,
+                uniqueness ? uniqueness + y * uniquenessStride : nullptr);
+            std::swap(_previousPaths, _currentPaths);
+            std::swap(_previousMins, _currentMins);
+        }
+    }
+
+private:
+    using Ops = CensusVectorOps;
+
+    static const int PADDING       = 16;
+    static const int BLOCK_STRIDE  = DISPARITIES + 2 * PADDING;
+    static const int GUARD_VALUE   = 0x3FFF;
+    static const int MAX_COST      = 24;
+    static const int MAX_PENALTY   = 0x1000;
+    static const int FORWARD_PATHS = 4;
+    static const int MAX_UNIQUENESS = 255;
+
+    enum Path { TOP, TOP_LEFT, TOP_RIGHT, LEFT };
+
+    void allocateBuffers(int width) noexcept
+    {
+        size_t blocksAmount = width + 2;
+        size_t pathBufferSize = FORWARD_PATHS * blocksAmount * BLOCK_STRIDE;
+
+        _reversedRight.assign(width, 0);
+        _costs.assign(width * DISPARITIES, 0);
+        _sums.assign(width * DISPARITIES, 0);
+        _previousPaths.assign(pathBufferSize, 0);
+        _currentPaths.assign(pathBufferSize, 0);
+        _previousMins.assign(FORWARD_PATHS * blocksAmount, 0);
+        _currentMins.assign(FORWARD_PATHS * blocksAmount, 0);
+        _backwardPaths.assign(2 * BLOCK_STRIDE, 0);
+
+        for(auto buffer : {&_previousPaths, &_currentPaths})
+            for(size_t block = 0; block < FORWARD_PATHS * blocksAmount; block++)
+                setGuards(buffer->data() + block * BLOCK_STRIDE);
+        setGuards(_backwardPaths.data());
+        setGuards(_backwardPaths.data() + BLOCK_STRIDE);
+        _blocksAmount = blocksAmount;
+    }
+
+    static void setGuards(uint16_t* block) noexcept
+    {
+        std::fill(block, block + PADDING, GUARD_VALUE);
+        std::fill(block + PADDING + DISPARITIES, block + BLOCK_STRIDE,
+                  GUARD_VALUE);
+    }
+
+    uint16_t* pathBlock(std::vector<uint16_t>& paths, Path path, int block)
+        noexcept
+    {
+        return paths.data() +
+               (path * _blocksAmount + block) * BLOCK_STRIDE + PADDING;
+    }
+
+    uint16_t& pathMin(std::vector<uint16_t>& mins, Path path, int block)
+        noexcept
+    {
+        return mins[path * _blocksAmount + block];
+    }
+
+    void reverseRow(const uint32_t* rightCensus, int width) noexcept
+    {
+        std::reverse_copy(rightCensus, rightCensus + width,
+                          _reversedRight.begin());
+    }
+
+    void computeRowCosts(const uint32_t* leftCensus, int width) noexcept
+    {
+        for(int x = 0; x < width; x++)
+        {
+            uint16_t* costs = _costs.data() + x * DISPARITIES;
+            int firstRight = x - _minDisparity;
+
+            if(firstRight - (DISPARITIES - 1) >= 0 && firstRight < width)
+                computePixelCosts(leftCensus[x],
+                                  _reversedRight.data() + width - 1 -
+                                  firstRight,
+                                  costs);
+            else
+                computeBorderPixelCosts(leftCensus[x], firstRight, width,
+                                        costs);
+        }
+    }
+
+    static void computePixelCosts(uint32_t leftCensus,
+                                  const uint32_t* reversedRight,
+                                  uint16_t* costs) noexcept
+    {
+#if defined(__AVX2__)
+        const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3,
+                                                1, 2, 2, 3, 2, 3, 3, 4,
+                                                0, 1, 1, 2, 1, 2, 2, 3,
+                                                1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i lowNibbles = _mm256_set1_epi8(0x0F);
+        const __m256i left = _mm256_set1_epi32(static_cast<int>(leftCensus));
+
+        for(int d = 0; d < DISPARITIES; d += 16)
+        {
+            __m256i first = popcount32(_mm256_xor_si256(left,
+                _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(reversedRight + d))),
+                lookup, lowNibbles);
+            __m256i second = popcount32(_mm256_xor_si256(left,
+                _mm256_loadu_si256(
+                    reinterpret_cast<const __m256i*>(reversedRight + d + 8))),
+                lookup, lowNibbles);
+            __m256i packed = _mm256_permute4x64_epi64(
+                _mm256_packus_epi32(first, second), 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(costs + d), packed);
+        }
+#else
+        for(int d = 0; d < DISPARITIES; d++)
+            costs[d] = popcount(leftCensus ^ reversedRight[d]);
+#endif
+    }
+
+#if defined(__AVX2__)
+    static __m256i popcount32(__m256i value,
+                              const __m256i& lookup,
+                              const __m256i& lowNibbles) noexcept
+    {
+        __m256i low  = _mm256_and_si256(value, lowNibbles);
+        __m256i high = _mm256_and_si256(_mm256_srli_epi16(value, 4),
+                                        lowNibbles);
+        __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low),
+                                        _mm256_shuffle_epi8(lookup, high));
+        __m256i words = _mm256_maddubs_epi16(bytes, _mm256_set1_epi8(1));
+        return _mm256_madd_epi16(words, _mm256_set1_epi16(1));
+    }
+#endif
+
+    static uint16_t popcount(uint32_t value) noexcept
+    {
+#if defined(__GNUC__)
+        return __builtin_popcount(value);
+#else
+        uint16_t bits = 0;
+        for(; value; value &= value - 1) bits++;
+        return bits;
+#endif
+    }
+
+    void computeBorderPixelCosts(uint32_t leftCensus,
+                                 int firstRight,
+                                 int width,
+                                 uint16_t* costs) const noexcept
+    {
+        for(int d = 0; d < DISPARITIES; d++)
+        {
+            int right = firstRight - d;
+            costs[d] = (right >= 0 && right < width)
+                       ? popcount(leftCensus ^
+                                  _reversedRight[width - 1 - right])
+                       : MAX_COST;
+        }
+    }
+
+    uint16_t aggregate(const uint16_t* costs,
+                       const uint16_t* previous,
+                       uint16_t previousMin,
+                       uint16_t* current,
+                       uint16_t* sums,
+                       bool isFirstPath) const noexcept
+    {
+        const typename Ops::Vector penalty1 = Ops::set(_smoothnessPar1);
+        const typename Ops::Vector jump =
+            Ops::set(previousMin + _smoothnessPar2);
+        const typename Ops::Vector minimum = Ops::set(previousMin);
+        typename Ops::Vector pathMinimum = Ops::set(GUARD_VALUE);
+
+        for(int d = 0; d < DISPARITIES; d += Ops::LANES)
+        {
+            typename Ops::Vector best = Ops::min(
+                Ops::min(Ops::load(previous + d),
+                         Ops::adds(Ops::load(previous + d - 1), penalty1)),
+                Ops::min(Ops::adds(Ops::load(previous + d + 1), penalty1),
+                         jump));
+            typename Ops::Vector value = Ops::subtract(
+                Ops::adds(Ops::load(costs + d), best), minimum);
+
+            Ops::store(current + d, value);
+            Ops::store(sums + d, isFirstPath
+                                 ? value
+                                 : Ops::adds(Ops::load(sums + d), value));
+            pathMinimum = Ops::min(pathMinimum, value);
+        }
+        return Ops::horizontalMin(pathMinimum);
+    }
+
+    void aggregateForwardPaths(int width) noexcept
+    {
+        for(int x = 0; x < width; x++)
+        {
+            const uint16_t* costs = _costs.data() + x * DISPARITIES;
+            uint16_t* sums = _sums.data() + x * DISPARITIES;
+            int block = x + 1;
+
+            pathMin(_currentMins, TOP, block) = aggregate(
+                costs,
+                pathBlock(_previousPaths, TOP, block),
+                pathMin(_previousMins, TOP, block),
+                pathBlock(_currentPaths, TOP, block),
+                sums, true);
+            pathMin(_currentMins, TOP_LEFT, block) = aggregate(
+                costs,
+                pathBlock(_previousPaths, TOP_LEFT, block - 1),
+                pathMin(_previousMins, TOP_LEFT, block - 1),
+                pathBlock(_currentPaths, TOP_LEFT, block),
+                sums, false);
+            pathMin(_currentMins, TOP_RIGHT, block) = aggregate(
+                costs,
+                pathBlock(_previousPaths, TOP_RIGHT, block + 1),
+                pathMin(_previousMins, TOP_RIGHT, block + 1),
+                pathBlock(_currentPaths, TOP_RIGHT, block),
+                sums, false);
+            pathMin(_currentMins, LEFT, block) = aggregate(
+                costs,
+                pathBlock(_currentPaths, LEFT, block - 1),
+                pathMin(_currentMins, LEFT, block - 1),
+                pathBlock(_currentPaths, LEFT, block),
+                sums, false);
+        }
+    }
+
+    void aggregateBackwardPathAndSelect(int width,
+                                        int16_t* disparity,
+                                        uint8_t* uniqueness) noexcept
+    {
+        uint16_t* previous = _backwardPaths.data() + PADDING;
+        uint16_t* current  = _backwardPaths.data() + BLOCK_STRIDE + PADDING;
+        uint16_t previousMin = 0;
+
+        std::fill(previous, previous + DISPARITIES, 0);
+        for(int x = width - 1; x >= 0; x--)
+        {
+            uint16_t* sums = _sums.data() + x * DISPARITIES;
+
+            previousMin = aggregate(_costs.data() + x * DISPARITIES,
+                                    previous, previousMin, current,
+                                    sums, false);
+            uint8_t pixelUniqueness = 0;
+            disparity[x] = selectDisparity(sums, x, pixelUniqueness);
+            if(uniqueness) uniqueness[x] = pixelUniqueness;
+            std::swap(previous, current);
+        }
+    }
+
+    int16_t selectDisparity(const uint16_t* sums,
+                            int x,
+                            uint8_t& uniqueness) const noexcept
+    {
+        int lastDisparity = std::min(_activeDisparities - 1,
+                                     x - _minDisparity);
+        if(lastDisparity < 0) return invalidDisparity();
+
+        int best = 0;
+        for(int d = 1; d <= lastDisparity; d++)
+            if(sums[d] < sums[best]) best = d;
+
+        int secondBest = -1;
+        for(int d = 0; d <= lastDisparity; d++)
+            if(std::abs(d - best) > 1 &&
+               (secondBest < 0 || sums[d] < sums[secondBest]))
+                secondBest = d;
+
+        uniqueness = MAX_UNIQUENESS;
+        if(secondBest >= 0)
+        {
+            if(sums[secondBest] * 100 < sums[best] * (100 + _uniquenessRatio))
+                return invalidDisparity();
+            uniqueness = MAX_UNIQUENESS *
+                         (sums[secondBest] - sums[best]) /
+                         std::max<int>(sums[secondBest], 1);
+        }
+
+        int scaled = (_minDisparity + best) * DISPARITY_SCALE;
+        if(best > 0 && best < lastDisparity)
+        {
+            int denominator = sums[best - 1] + sums[best + 1] -
+                              2 * sums[best];
+            if(denominator > 0)
+                scaled += (DISPARITY_SCALE * (sums[best - 1] -
+                                              sums[best + 1]) +
+                           denominator) / (2 * denominator);
+        }
+        return static_cast<int16_t>(scaled);
+    }
+
+
+
+    int _minDisparity      = 0;
+    int _activeDisparities = DISPARITIES;
+    int _smoothnessPar1    = 8;
+    int _smoothnessPar2    = 96;
+    int _uniquenessRatio   = 10;
+
+    size_t _blocksAmount = 0;
+
+    std::vector<uint32_t> _reversedRight;
+    std::vector<uint16_t> _costs;
+    std::vector<uint16_t> _sums;
+    std::vector<uint16_t> _previousPaths;
+    std::vector<uint16_t> _currentPaths;
+    std::vector<uint16_t> _previousMins;
+    std::vector<uint16_t> _currentMins;
+    std::vector<uint16_t> _backwardPaths;
+};
+
+template<int DISPARITIES> const int CensusMatcher<DISPARITIES>::DISPARITY_SCALE;
+template<int DISPARITIES> const int CensusMatcher<DISPARITIES>::CENSUS_RADIUS;
+template<int DISPARITIES> const int CensusMatcher<DISPARITIES>::PADDING;
+template<int DISPARITIES> const int CensusMatcher<DISPARITIES>::BLOCK_STRIDE;
+template<int DISPARITIES> const int CensusMatcher<DISPARITIES>::GUARD_VALUE;
+template<int DISPARITIES> const int CensusMatcher<DISPARITIES>::MAX_COST;
+template<int DISPARITIES> const int CensusMatcher<DISPARITIES>::MAX_PENALTY;
+template<int DISPARITIES> const int CensusMatcher<DISPARITIES>::FORWARD_PATHS;
+template<int DISPARITIES> const int CensusMatcher<DISPARITIES>::MAX_UNIQUENESS;
+
+#endif // CENSUSMATCHER_H
@@ -30,4 +30,40 @@ public:
     }
 };
 
+class CamerasAmountError : public std::exception
+{
+public:
+    virtual const char* what() const noexcept
+    {
+        return "Do kalibracji ukladu potrzebne sa co najmniej dwie kamery";
+    }
+};
+
+class ReferenceCameraError : public std::exception
+{
+public:
+    virtual const char* what() const noexcept
+    {
+        return "Nieprawidlowy numer kamery referencyjnej";
+    }
+};
+
+class MissingIntrinsicsError : public std::exception
+{
+public:
+    virtual const char* what() const noexcept
+    {
+        return "Brak parametrow wewnetrznych dla kazdej kamery";
+    }
+};
+
+class UnsupportedPatternError : public std::exception
+{
+public:
+    virtual const char* what() const noexcept
+    {
+        return "Wzorzec ChArUco wymaga OpenCV z modulem aruco";
+    }
+};
+
 #endif /* CALIBRATIONEXCEPTIONS_H_ */
@@ -0,0 +1,106 @@
+#include "ConfidenceEstimator.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+class ConfidenceCombiner : public cv::ParallelLoopBody
+{
+public:
+    ConfidenceCombiner(const cv::Mat& leftDisparity,
+                       const cv::Mat& rightDisparity,
+                       const cv::Mat& uniqueness,
+                       const cv::Mat& texture,
+                       int minDisparity,
+                       int leftRightTolerance,
+                       cv::Mat& confidence) noexcept
+        : _leftDisparity(leftDisparity),
+          _rightDisparity(rightDisparity),
+          _uniqueness(uniqueness),
+          _texture(texture),
+          _minDisparity(minDisparity * ConfidenceEstimator::DISPARITY_SCALE),
+          _tolerance(leftRightTolerance * ConfidenceEstimator::DISPARITY_SCALE),
+          _confidence(confidence)
+    {
+    }
+
+    void operator()(const cv::Range& rows) const
+    {
+        for(int y = rows.start; y < rows.end; y++)
+        {
+            const int16_t* left = _leftDisparity.ptr<int16_t>(y);
+            const uint8_t* texture = _texture.ptr<uint8_t>(y);
+            uint8_t* confidence = _confidence.ptr<uint8_t>(y);
+
+            for(int x = 0; x < _leftDisparity.cols; x++)
+            {
+                if(left[x] < _minDisparity)
+                {
+                    confidence[x] = 0;
+                    continue;
+                }
+
+                int value = texture[x];
+                if(!_uniqueness.empty())
+                    value = std::min<int>(value, _uniqueness.ptr<uint8_t>(y)[x]);
+                if(!_rightDisparity.empty() && !agrees(left[x], x, y))
+                    value = 0;
+                confidence[x] = static_cast<uint8_t>(value);
+            }
+        }
+    }
+
+private:
+    bool agrees(int16_t disparity, int x, int y) const
+    {
+        int rightX = x - (disparity + ConfidenceEstimator::DISPARITY_SCALE / 2) /
+                         ConfidenceEstimator::DISPARITY_SCALE;
+        if(rightX < 0 || rightX >= _rightDisparity.cols) return false;
+
+        int16_t rightDisparity = _rightDisparity.ptr<int16_t>(y)[rightX];
+        return rightDisparity >= _minDisparity &&
+               std::abs(disparity - rightDisparity) <= _tolerance;
+    }
+
+    const cv::Mat& _leftDisparity;
+    const cv::Mat& _rightDisparity;
+    const cv::Mat& _uniqueness;
+    const cv::Mat& _texture;
+    const int _minDisparity;
+    const int _tolerance;
+    cv::Mat& _confidence;
+};
+
+void ConfidenceEstimator::compute(const cv::Mat& leftImage,
+                                  const cv::Mat& leftDisparity,
+                                  const cv::Mat& rightDisparity,
+                                  const cv::Mat& uniqueness,
+                                  int minDisparity,
+                                  cv::Mat& confidence) noexcept
+{
+    computeTexture(leftImage);
+    confidence.create(leftDisparity.size(), CV_8U);
+    cv::parallel_for_(cv::Range(0, leftDisparity.rows),
+                      ConfidenceCombiner(leftDisparity, rightDisparity,
+                                         uniqueness, _texture, minDisparity,
+                                         _leftRightTolerance, confidence));
+}
+
+void ConfidenceEstimator::setTextureSaturation(int textureSaturation) noexcept
+{
+    _textureSaturation = std::max(textureSaturation, 1);
+}
+
+void ConfidenceEstimator::setLeftRightTolerance(int leftRightTolerance)
+    noexcept
+{
+    _leftRightTolerance = leftRightTolerance;
+}
+
+void ConfidenceEstimator::computeTexture(const cv::Mat& image) noexcept
+{
+    cv::Sobel(image, _gradient, CV_16S, 1, 0);
+    cv::convertScaleAbs(_gradient, _texture,
+                        static_cast<double>(MAX_CONFIDENCE) / _textureSaturation);
+    cv::boxFilter(_texture, _texture, -1,
+                  cv::Size(TEXTURE_WINDOW, TEXTURE_WINDOW));
+}
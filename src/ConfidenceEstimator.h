@@ -0,0 +1,37 @@
+#ifndef CONFIDENCEESTIMATOR_H
+#define CONFIDENCEESTIMATOR_H
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+class ConfidenceEstimator
+{
+public:
+    void compute(const cv::Mat& leftImage,
+                 const cv::Mat& leftDisparity,
+                 const cv::Mat& rightDisparity,
+                 const cv::Mat& uniqueness,
+                 int minDisparity,
+                 cv::Mat& confidence) noexcept;
+
+    void setTextureSaturation(int textureSaturation) noexcept;
+    void setLeftRightTolerance(int leftRightTolerance) noexcept;
+
+    static const int DISPARITY_SCALE = 16;
+    static const int MAX_CONFIDENCE  = 255;
+
+private:
+    void computeTexture(const cv::Mat& image) noexcept;
+
+
+
+    cv::Mat _gradient;
+    cv::Mat _texture;
+
+    int _textureSaturation  = 32;
+    int _leftRightTolerance = 1;
+
+    const int TEXTURE_WINDOW = 5;
+};
+
+#endif // CONFIDENCEESTIMATOR_H
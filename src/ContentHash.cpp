@@ -0,0 +1,36 @@
+#include "ContentHash.h"
+
+#include <cstring>
+
+ContentHash& ContentHash::add(const cv::Mat& matrix) noexcept
+{
+    add(matrix.rows);
+    add(matrix.cols);
+    add(matrix.type());
+
+    size_t rowBytes = matrix.cols * matrix.elemSize();
+    for(int row = 0; row < matrix.rows; row++)
+        add(matrix.ptr(row), rowBytes);
+    return *this;
+}
+
+ContentHash& ContentHash::add(const void* data, size_t bytesAmount) noexcept
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    size_t i = 0;
+
+    for(; i + sizeof(uint64_t) <= bytesAmount; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        _value = (_value ^ word) * FNV_PRIME;
+    }
+    for(; i < bytesAmount; i++)
+        _value = (_value ^ bytes[i]) * FNV_PRIME;
+    return *this;
+}
+
+ContentHash& ContentHash::add(int64_t value) noexcept
+{
+    return add(&value, sizeof(value));
+}
@@ -0,0 +1,27 @@
+#ifndef CONTENTHASH_H
+#define CONTENTHASH_H
+
+#include <opencv2/core/core.hpp>
+
+#include <cstdint>
+#include <cstddef>
+
+class ContentHash
+{
+public:
+    ContentHash() noexcept {}
+
+    ContentHash& add(const cv::Mat& matrix) noexcept;
+    ContentHash& add(const void* data, size_t bytesAmount) noexcept;
+    ContentHash& add(int64_t value) noexcept;
+
+    uint64_t value() const noexcept { return _value; }
+
+private:
+    static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    static const uint64_t FNV_PRIME        = 1099511628211ULL;
+
+    uint64_t _value = FNV_OFFSET_BASIS;
+};
+
+#endif // CONTENTHASH_H
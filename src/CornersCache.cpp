@@ -0,0 +1,102 @@
+#include "CornersCache.h"
+#include "ContentHash.h"
+
+#include <fstream>
+
+CornersCache::CornersCache(const std::string& path) noexcept
+    : _path(path)
+{
+    load();
+}
+
+uint64_t CornersCache::key(const cv::Mat& image,
+                           const cv::Size& boardSize,
+                           int detectionFlags) noexcept
+{
+    return ContentHash().add(image)
+                        .add(boardSize.width)
+                        .add(boardSize.height)
+                        .add(detectionFlags)
+                        .value();
+}
+
+bool CornersCache::find(uint64_t key, vector<cv::Point2f>& corners)
+    const noexcept
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto entry = _entries.find(key);
+    if(entry == _entries.end()) return false;
+    corners = entry->second;
+    return true;
+}
+
+void CornersCache::insert(uint64_t key, const vector<cv::Point2f>& corners)
+    noexcept
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _entries[key] = corners;
+    _modified = true;
+}
+
+void CornersCache::load() noexcept
+{
+    std::ifstream input(_path, std::ifstream::binary | std::ifstream::ate);
+    uint32_t magic = 0, version = 0;
+    uint64_t entriesAmount = 0;
+
+    const std::streamoff fileSize = input.tellg();
+    input.seekg(0);
+
+    input.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    input.read(reinterpret_cast<char*>(&version), sizeof(version));
+    input.read(reinterpret_cast<char*>(&entriesAmount), sizeof(entriesAmount));
+    if(!input || magic != FILE_MAGIC || version != FILE_VERSION) return;
+
+    for(uint64_t i = 0; i < entriesAmount && input; i++)
+    {
+        uint64_t key = 0;
+        uint32_t cornersAmount = 0;
+
+        input.read(reinterpret_cast<char*>(&key), sizeof(key));
+        input.read(reinterpret_cast<char*>(&cornersAmount),
+                   sizeof(cornersAmount));
+        if(!input || cornersAmount * sizeof(cv::Point2f) >
+                     static_cast<uint64_t>(fileSize - input.tellg()))
+            break;
+
+        vector<cv::Point2f> corners(cornersAmount);
+        input.read(reinterpret_cast<char*>(corners.data()),
+                   cornersAmount * sizeof(cv::Point2f));
+        if(input) _entries[key] = corners;
+    }
+}
+
+void CornersCache::save() noexcept
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if(!_modified) return;
+
+    std::ofstream output(_path, std::ofstream::binary | std::ofstream::trunc);
+    uint64_t entriesAmount = _entries.size();
+
+    output.write(reinterpret_cast<const char*>(&FILE_MAGIC), sizeof(FILE_MAGIC));
+    output.write(reinterpret_cast<const char*>(&FILE_VERSION),
+                 sizeof(FILE_VERSION));
+    output.write(reinterpret_cast<const char*>(&entriesAmount),
+                 sizeof(entriesAmount));
+
+    for(auto& entry : _entries)
+    {
+        uint32_t cornersAmount = entry.second.size();
+
+        output.write(reinterpret_cast<const char*>(&entry.first),
+                     sizeof(entry.first));
+        output.write(reinterpret_cast<const char*>(&cornersAmount),
+                     sizeof(cornersAmount));
+        output.write(reinterpret_cast<const char*>(entry.second.data()),
+                     cornersAmount * sizeof(cv::Point2f));
+    }
+    _modified = !output;
+}
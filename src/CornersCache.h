@@ -0,0 +1,43 @@
+#ifndef CORNERSCACHE_H
+#define CORNERSCACHE_H
+
+#include <opencv2/core/core.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+
+using std::vector;
+
+class CornersCache
+{
+public:
+    CornersCache(const std::string& path) noexcept;
+
+    static uint64_t key(const cv::Mat& image,
+                        const cv::Size& boardSize,
+                        int detectionFlags) noexcept;
+
+    bool find(uint64_t key, vector<cv::Point2f>& corners) const noexcept;
+    void insert(uint64_t key, const vector<cv::Point2f>& corners) noexcept;
+
+    void save() noexcept;
+
+private:
+    void load() noexcept;
+
+
+
+    std::string _path;
+    std::unordered_map<uint64_t, vector<cv::Point2f>> _entries;
+    bool _modified = false;
+
+    mutable std::mutex _mutex;
+
+    const uint32_t FILE_MAGIC   = 0x31434343;
+    const uint32_t FILE_VERSION = 1;
+};
+
+#endif // CORNERSCACHE_H
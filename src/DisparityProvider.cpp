@@ -1,11 +1,80 @@
 #include "DisparityProvider.h"
 
+DisparityProvider::DisparityProvider() noexcept
+    : _sgbmBackend(std::make_shared<SGBMBackend>()),
+      _bmBackend(std::make_shared<BMBackend>()),
+      _censusBackend(std::make_shared<CensusBackend>()),
+      _backend(_sgbmBackend)
+{
+    loadMatcherParameters();
+}
+
 DisparityProvider::DisparityProvider(std::string& pathToRectifyMaps) noexcept
-    : _stereoSGBMState(0,768,9,200,255,1)
+    : DisparityProvider()
 {
     loadRectifyMaps(pathToRectifyMaps);
 }
 
+DisparityProvider::DisparityProvider(const RectifyMaps& rectifyMaps) noexcept
+    : DisparityProvider()
+{
+    setRectifyMaps(rectifyMaps);
+}
+
+void DisparityProvider::useSGBMBackend() noexcept
+{
+    _backend = _sgbmBackend;
+}
+
+void DisparityProvider::useBMBackend() noexcept
+{
+    _backend = _bmBackend;
+}
+
+void DisparityProvider::useCensusBackend() noexcept
+{
+    _backend = _censusBackend;
+}
+
+void DisparityProvider::benchmarkBackends(
+        const std::vector<std::pair<std::string, std::string>>& imagePairs)
+    noexcept
+{
+    std::vector<cv::Mat> leftImages, rightImages;
+
+    for(auto& imagePair : imagePairs)
+    {
+        if(!prepareImages(imagePair.first, imagePair.second)) continue;
+        leftImages.push_back(_workspace.leftImage.clone());
+        rightImages.push_back(_workspace.rightImage.clone());
+    }
+    StereoMatcherBenchmark({_sgbmBackend, _bmBackend, _censusBackend})
+        .run(leftImages, rightImages);
+}
+
+void DisparityProvider::startRecordingDisparityMaps(const std::string& path)
+    noexcept
+{
+    _recorder = std::make_shared<DisparitySequenceRecorder>(path);
+}
+
+void DisparityProvider::stopRecordingDisparityMaps() noexcept
+{
+    _recorder.reset();
+}
+
+void DisparityProvider::enableConfidenceMap(bool leftRightCheck) noexcept
+{
+    _confidenceEnabled = true;
+    _leftRightCheck = leftRightCheck;
+}
+
+void DisparityProvider::disableConfidenceMap() noexcept
+{
+    _confidenceEnabled = false;
+    _workspace.confidence.release();
+}
+
 void DisparityProvider::loadRectifyMaps(std::string& pathToRectifyMaps) noexcept
 {
     cv::FileStorage fileStorage(pathToRectifyMaps, cv::FileStorage::READ);
@@ -14,11 +83,81 @@ void DisparityProvider::loadRectifyMaps(std::string& pathToRectifyMaps) noexcept
     fileStorage[RECTIFY_MAP_X2_TITLE] >> _rectifyMapXRight;
     fileStorage[RECTIFY_MAP_Y2_TITLE] >> _rectifyMapYRight;
     fileStorage.release();
+
+    initUndistorters();
+}
+
+void DisparityProvider::setRectifyMaps(const RectifyMaps& rectifyMaps) noexcept
+{
+    _rectifyMapXLeft  = rectifyMaps.leftX;
+    _rectifyMapYLeft  = rectifyMaps.leftY;
+    _rectifyMapXRight = rectifyMaps.rightX;
+    _rectifyMapYRight = rectifyMaps.rightY;
+
+    initUndistorters();
+}
+
+void DisparityProvider::initUndistorters() noexcept
+{
+    _leftUndistorter  = Undistorter(_rectifyMapXLeft, _rectifyMapYLeft);
+    _rightUndistorter = Undistorter(_rectifyMapXRight, _rectifyMapYRight);
+    _workspace.reserve(_rectifyMapXLeft.size());
+}
+
+void DisparityProvider::setAllocationCheck(int warmUpFrames) noexcept
+{
+    _allocationCheckWarmUp = warmUpFrames;
+    _checkedFrames = 0;
+
+    if(warmUpFrames >= 0 && !AllocationCounter::isEnabled())
+        std::cerr << ALLOCATION_COUNTER_DISABLED << std::endl;
+}
+
+void DisparityProvider::startCountingAllocations() noexcept
+{
+    _allocationsAtFrameStart = AllocationCounter::count();
+}
+
+void DisparityProvider::checkAllocations() noexcept
+{
+    if(_allocationCheckWarmUp < 0) return;
+
+    _lastAllocations = AllocationCounter::count() - _allocationsAtFrameStart;
+    if(++_checkedFrames > _allocationCheckWarmUp && _lastAllocations > 0)
+        std::cerr << ALLOCATIONS_AFTER_WARM_UP << _lastAllocations
+                  << std::endl;
+}
+
+const cv::Mat& DisparityProvider::computeDisparityMap(
+        const cv::Mat& leftImage, const cv::Mat& rightImage) noexcept
+{
+    prepareImages(leftImage, rightImage);
+    computeRawDisparityMap();
+    return _workspace.disparity;
 }
 
 void DisparityProvider::computeAndDisplayDisparityMap(
         std::string& leftImage, std::string& rightImage) noexcept
 {
+    if(!prepareImages(leftImage, rightImage)) return;
+    computeDisparityMap();
+
+    updateMapWindow();
+    showOptionsWindow();
+
+    addSliders();
+    handleKeyInterruptions();
+}
+
+void DisparityProvider::computeAndDisplayDisparityMap(
+        const FrameSetReader& recording, int frameSet) noexcept
+{
+    cv::Mat leftImage, rightImage;
+
+    if(!recording.read(frameSet, 0, leftImage) ||
+       !recording.read(frameSet, 1, rightImage))
+        return;
+
     prepareImages(leftImage, rightImage);
     computeDisparityMap();
 
@@ -29,106 +168,204 @@ void DisparityProvider::computeAndDisplayDisparityMap(
     handleKeyInterruptions();
 }
 
+void DisparityProvider::computeRawDisparityMap() noexcept
+{
+    if(_confidenceEnabled)
+        _backend->computeWithUniqueness(_workspace.leftImage,
+                                        _workspace.rightImage,
+                                        _workspace.disparity,
+                                        _workspace.uniqueness);
+    else
+        _backend->compute(_workspace.leftImage, _workspace.rightImage,
+                          _workspace.disparity);
+
+    if(_recorder) _recorder->add(_workspace.disparity);
+    if(_confidenceEnabled) computeConfidenceMap();
+    checkAllocations();
+}
+
+void DisparityProvider::computeConfidenceMap() noexcept
+{
+    if(_leftRightCheck)
+        computeRightDisparityMap();
+    else
+        _workspace.rightDisparity.release();
+
+    _confidenceEstimator.compute(_workspace.leftImage,
+                                 _workspace.disparity,
+                                 _workspace.rightDisparity,
+                                 _workspace.uniqueness,
+                                 _backend->parameters().minDisparity,
+                                 _workspace.confidence);
+}
+
+void DisparityProvider::computeRightDisparityMap() noexcept
+{
+    cv::flip(_workspace.leftImage, _workspace.flippedLeftImage, 1);
+    cv::flip(_workspace.rightImage, _workspace.flippedRightImage, 1);
+    _backend->compute(_workspace.flippedRightImage,
+                      _workspace.flippedLeftImage,
+                      _workspace.flippedDisparity);
+    cv::flip(_workspace.flippedDisparity, _workspace.rightDisparity, 1);
+}
+
 void DisparityProvider::computeDisparityMap() noexcept
 {
-    _stereoSGBMState(_leftImage, _rightImage, _disparity);
-    cv::normalize(_disparity, _disparityBlackWhite, 0, 255, CV_MINMAX, CV_8U);
+    computeRawDisparityMap();
+    normalizeDisparityMap();
+}
+
+void DisparityProvider::requestDisparityMap(bool debounce) noexcept
+{
+    if(!_worker) _worker.reset(new DisparityWorker());
+    _worker->request(_backend->name(), _backend->parameters(),
+                     _workspace.leftImage, _workspace.rightImage, debounce);
+}
+
+void DisparityProvider::updateFromWorker() noexcept
+{
+    bool isFinal = false;
 
-    cv::Mat mask;
+    if(!_worker || !_worker->takeResult(_workspace.disparity, isFinal)) return;
 
-    cv::inRange(_disparityBlackWhite,
+    if(isFinal && _recorder) _recorder->add(_workspace.disparity);
+    normalizeDisparityMap();
+    updateMapWindow();
+}
+
+void DisparityProvider::normalizeDisparityMap() noexcept
+{
+    cv::normalize(_workspace.disparity, _workspace.disparityBlackWhite,
+                  0, 255, CV_MINMAX, CV_8U);
+
+    cv::inRange(_workspace.disparityBlackWhite,
                 cv::Scalar(_backgroundRemovalSlider),
                 cv::Scalar(255 - _foregroundRemovalSlider),
-                mask);
-    cv::bitwise_and(_disparityBlackWhite, mask, _disparityBlackWhite);
+                _workspace.mask);
+    cv::bitwise_and(_workspace.disparityBlackWhite, _workspace.mask,
+                    _workspace.disparityBlackWhite);
 }
 
-void DisparityProvider::prepareImages(std::string& leftImage,
-                                      std::string& rightImage) noexcept
+bool DisparityProvider::prepareImages(const std::string& leftImage,
+                                      const std::string& rightImage) noexcept
 {
-    loadGrayImages(leftImage, rightImage);
+    startCountingAllocations();
+    if(!loadGrayImages(leftImage, rightImage)) return false;
+
     remapImages();
+    return true;
 }
 
-void DisparityProvider::loadGrayImages(std::string& leftImage,
-                                       std::string& rightImage) noexcept
+void DisparityProvider::prepareImages(const cv::Mat& leftImage,
+                                      const cv::Mat& rightImage) noexcept
 {
-    cv::Mat image;
-    image  = cv::imread(leftImage);
-    cv::cvtColor(image, _leftImage, CV_BGR2GRAY);
-    image = cv::imread(rightImage);
-    cv::cvtColor(image, _rightImage, CV_BGR2GRAY);
+    startCountingAllocations();
+    remapImages(convertToGray(leftImage, _workspace.leftGrayImage),
+                convertToGray(rightImage, _workspace.rightGrayImage));
 }
 
-void DisparityProvider::remapImages() noexcept
+const cv::Mat& DisparityProvider::convertToGray(const cv::Mat& image,
+                                                cv::Mat& grayImage)
+    const noexcept
 {
-    _leftImage  = remapImage(_leftImage,  _rectifyMapXLeft,  _rectifyMapYLeft);
-    _rightImage = remapImage(_rightImage, _rectifyMapXRight, _rectifyMapYRight);
+    if(image.channels() == 1) return image;
+
+    cv::cvtColor(image, grayImage, CV_BGR2GRAY);
+    return grayImage;
+}
+
+bool DisparityProvider::loadGrayImages(const std::string& leftImage,
+                                       const std::string& rightImage) noexcept
+{
+    return loadGrayImage(leftImage, _workspace.leftGrayImage) &&
+           loadGrayImage(rightImage, _workspace.rightGrayImage);
 }
 
-cv::Mat DisparityProvider::remapImage(cv::Mat& image,
-                                      cv::Mat& rectifyMapX,
-                                      cv::Mat& rectifyMapY) const noexcept
+bool DisparityProvider::loadGrayImage(const std::string& path,
+                                      cv::Mat& grayImage) noexcept
 {
-    cv::Mat remappedImage;
+    if(_workspace.loadFile(path) &&
+       !cv::imdecode(_workspace.fileBuffer, CV_LOAD_IMAGE_GRAYSCALE,
+                     &grayImage).empty())
+        return true;
 
-    cv::remap(image, remappedImage, rectifyMapX, rectifyMapY, cv::INTER_LINEAR);
+    std::cerr << IMAGE_LOAD_FAILED << path << std::endl;
+    return false;
+}
+
+void DisparityProvider::remapImages() noexcept
+{
+    remapImages(_workspace.leftGrayImage, _workspace.rightGrayImage);
+}
 
-    return remappedImage;
+void DisparityProvider::remapImages(const cv::Mat& leftGrayImage,
+                                    const cv::Mat& rightGrayImage) noexcept
+{
+    _leftUndistorter.apply(leftGrayImage, _workspace.leftImage);
+    _rightUndistorter.apply(rightGrayImage, _workspace.rightImage);
 }
 
 void DisparityProvider::callbackMinDisparitySlider(int newValue, void* object)
 {
     DisparityProvider* dispProvider = (DisparityProvider*) object;
-    dispProvider->_stereoSGBMState.minDisparity = newValue - 50;
+    dispProvider->_backend->parameters().minDisparity = newValue - 50;
+    dispProvider->requestDisparityMap();
 }
 
 void DisparityProvider::callbackSADWindowsSizeSlider(int newValue, void* object)
 {
     DisparityProvider* dispProvider = (DisparityProvider*) object;
-    dispProvider->_stereoSGBMState.SADWindowSize = 2 * newValue + 5;
+    dispProvider->_backend->parameters().blockSize = 2 * newValue + 5;
+    dispProvider->requestDisparityMap();
 }
 
 void DisparityProvider::callbackDisp12MaxDiffSlider(int newValue, void* object)
 {
     DisparityProvider* dispProvider = (DisparityProvider*) object;
-    dispProvider->_stereoSGBMState.disp12MaxDiff = newValue;
+    dispProvider->_backend->parameters().disp12MaxDiff = newValue;
+    dispProvider->requestDisparityMap();
 }
 
 void DisparityProvider::callbackPreFilterCapSlider(int newValue, void* object)
 {
     DisparityProvider* dispProvider = (DisparityProvider*) object;
-    dispProvider->_stereoSGBMState.preFilterCap = newValue;
+    dispProvider->_backend->parameters().preFilterCap = newValue;
+    dispProvider->requestDisparityMap();
 }
 
 void DisparityProvider::callbackUniquenessRatioSlider(int newValue, void* object)
 {
     DisparityProvider* dispProvider = (DisparityProvider*) object;
-    dispProvider->_stereoSGBMState.uniquenessRatio = newValue;
+    dispProvider->_backend->parameters().uniquenessRatio = newValue;
+    dispProvider->requestDisparityMap();
 }
 
 void DisparityProvider::callbackSpecleWindowSizeSlider(int newValue, void* object)
 {
     DisparityProvider* dispProvider = (DisparityProvider*) object;
-    dispProvider->_stereoSGBMState.speckleWindowSize = newValue;
+    dispProvider->_backend->parameters().speckleWindowSize = newValue;
+    dispProvider->requestDisparityMap();
 }
 
 void DisparityProvider::callbackSpecleRangeSlider(int newValue, void* object)
 {
     DisparityProvider* dispProvider = (DisparityProvider*) object;
-    dispProvider->_stereoSGBMState.speckleRange = newValue;
+    dispProvider->_backend->parameters().speckleRange = newValue;
+    dispProvider->requestDisparityMap();
 }
 
 void DisparityProvider::callbackSmoothnessPar1Slider(int newValue, void* object)
 {
     DisparityProvider* dispProvider = (DisparityProvider*) object;
-    dispProvider->_stereoSGBMState.P1 = newValue;
+    dispProvider->_backend->parameters().smoothnessPar1 = newValue;
+    dispProvider->requestDisparityMap();
 }
 
 void DisparityProvider::callbackSmoothnessPar2Slider(int newValue, void* object)
 {
     DisparityProvider* dispProvider = (DisparityProvider*) object;
-    dispProvider->_stereoSGBMState.P2 = newValue;
+    dispProvider->_backend->parameters().smoothnessPar2 = newValue;
+    dispProvider->requestDisparityMap();
 }
 
 void DisparityProvider::callbackBackgroundRemovalSlider(int, void*)
@@ -142,112 +379,120 @@ void DisparityProvider::callbackForegroundRemovalSlider(int, void*)
 void DisparityProvider::callbackNumDisparitiesSlider(int newValue, void* object)
 {
     DisparityProvider* dispProvider = (DisparityProvider*) object;
-    dispProvider->_stereoSGBMState.numberOfDisparities = 16 * newValue;
+    dispProvider->_backend->parameters().numberOfDisparities = 16 * newValue;
+    if(dispProvider->_backend->clampParameters())
+        DisplayManager::setTrackbarPos(
+                dispProvider->NUM_DISPARITIES_TRACKBAR_TITLE,
+                dispProvider->OPTIONS_WINDOW_TITLE,
+                dispProvider->_backend->parameters().numberOfDisparities / 16);
+    dispProvider->requestDisparityMap();
 }
 
 void DisparityProvider::callbackGenerateSlider(int, void* object)
 {
     DisparityProvider* dispProvider = (DisparityProvider*) object;
-    std::cout << "Generating disparity map... ";
-    dispProvider->computeDisparityMap();
-    std::cout << "done\n";
-    dispProvider->updateMapWindow();
+    dispProvider->requestDisparityMap(false);
 }
 
 void DisparityProvider::addSliders() noexcept
 {
-    cv::createTrackbar(GENERATE_SLIDER_TITLE,
-                       OPTIONS_WINDOW_TITLE,
-                       &_generateSlider,
-                       1,
-                       callbackGenerateSlider, this);
-    cv::createTrackbar(MIN_DISPARITY_TRACKBAR_TITLE,
-                       OPTIONS_WINDOW_TITLE,
-                       &_minDisparitySlider,
-                       _maxMinDisparity,
-                       callbackMinDisparitySlider, this);
-    cv::createTrackbar(NUM_DISPARITIES_TRACKBAR_TITLE,
-                       OPTIONS_WINDOW_TITLE,
-                       &_numDisparitiesSlider,
-                       _maxNumDisparities,
-                       callbackNumDisparitiesSlider, this);
-    cv::createTrackbar(SAD_WINDOWS_SIZE_TRACKBAR_TITLE,
-                       OPTIONS_WINDOW_TITLE,
-                       &_SADWindowSizeSlider,
-                       _maxSADWindowSize,
-                       callbackSADWindowsSizeSlider, this);
-    cv::createTrackbar(DISP12_MAX_DIFF_TRACKBAR_TITLE,
-                       OPTIONS_WINDOW_TITLE,
-                       &_disp12MaxDiffSlider,
-                       _maxDisp12MaxDiff,
-                       callbackDisp12MaxDiffSlider, this);
-    cv::createTrackbar(PREFILTER_CAP_TRACKBAR_TITLE,
-                       OPTIONS_WINDOW_TITLE,
-                       &_preFilterCapSlider,
-                       _maxPreFilterCap,
-                       callbackPreFilterCapSlider, this);
-    cv::createTrackbar(UNIQUENESS_RATIO_TRACKBAR_TITLE,
-                       OPTIONS_WINDOW_TITLE,
-                       &_uniquenessRatioSlider,
-                       _maxUniquenessRatio,
-                       callbackUniquenessRatioSlider, this);
-    cv::createTrackbar(SPECKLE_WINDOW_SIZE_TRACKBAR_TITLE,
-                       OPTIONS_WINDOW_TITLE,
-                       &_speckleWindowSizeSlider,
-                       _maxSpeckleWindowSize,
-                       callbackSpecleWindowSizeSlider, this);
-    cv::createTrackbar(SPECKLE_RANGE_TRACKBAR_TITLE,
-                       OPTIONS_WINDOW_TITLE,
-                       &_speckleRangeSlider,
-                       _maxSpeckleRange,
-                       callbackSpecleRangeSlider, this);
-    cv::createTrackbar(SMOOTHNESS_PAR1_TRACKBAR_TITLE,
-                       OPTIONS_WINDOW_TITLE,
-                       &_smoothnessPar1Slider,
-                       _maxSmoothnessPar1,
-                       callbackSmoothnessPar1Slider, this);
-    cv::createTrackbar(SMOOTHNESS_PAR2_TRACKBAR_TITLE,
-                       OPTIONS_WINDOW_TITLE,
-                       &_smoothnessPar2Slider,
-                       _maxSmoothnessPar2,
-                       callbackSmoothnessPar2Slider, this);
-    cv::createTrackbar(BACKGROUND_REMOVAL_TRACKBAR_TITLE,
-                       OPTIONS_WINDOW_TITLE,
-                       &_backgroundRemovalSlider,
-                       _maxBackgroundRemoval,
-                       callbackBackgroundRemovalSlider);
-    cv::createTrackbar(FOREGROUND_REMOVAL_TRACKBAR_TITLE,
-                       OPTIONS_WINDOW_TITLE,
-                       &_foregroundRemovalSlider,
-                       _maxForegroundRemoval,
-                       callbackForegroundRemovalSlider);
+    DisplayManager::createTrackbar(GENERATE_SLIDER_TITLE,
+                                   OPTIONS_WINDOW_TITLE,
+                                   &_generateSlider,
+                                   1,
+                                   callbackGenerateSlider, this);
+    DisplayManager::createTrackbar(MIN_DISPARITY_TRACKBAR_TITLE,
+                                   OPTIONS_WINDOW_TITLE,
+                                   &_minDisparitySlider,
+                                   _maxMinDisparity,
+                                   callbackMinDisparitySlider, this);
+    DisplayManager::createTrackbar(NUM_DISPARITIES_TRACKBAR_TITLE,
+                                   OPTIONS_WINDOW_TITLE,
+                                   &_numDisparitiesSlider,
+                                   _maxNumDisparities,
+                                   callbackNumDisparitiesSlider, this);
+    DisplayManager::createTrackbar(SAD_WINDOWS_SIZE_TRACKBAR_TITLE,
+                                   OPTIONS_WINDOW_TITLE,
+                                   &_SADWindowSizeSlider,
+                                   _maxSADWindowSize,
+                                   callbackSADWindowsSizeSlider, this);
+    DisplayManager::createTrackbar(DISP12_MAX_DIFF_TRACKBAR_TITLE,
+                                   OPTIONS_WINDOW_TITLE,
+                                   &_disp12MaxDiffSlider,
+                                   _maxDisp12MaxDiff,
+                                   callbackDisp12MaxDiffSlider, this);
+    DisplayManager::createTrackbar(PREFILTER_CAP_TRACKBAR_TITLE,
+                                   OPTIONS_WINDOW_TITLE,
+                                   &_preFilterCapSlider,
+                                   _maxPreFilterCap,
+                                   callbackPreFilterCapSlider, this);
+    DisplayManager::createTrackbar(UNIQUENESS_RATIO_TRACKBAR_TITLE,
+                                   OPTIONS_WINDOW_TITLE,
+                                   &_uniquenessRatioSlider,
+                                   _maxUniquenessRatio,
+                                   callbackUniquenessRatioSlider, this);
+    DisplayManager::createTrackbar(SPECKLE_WINDOW_SIZE_TRACKBAR_TITLE,
+                                   OPTIONS_WINDOW_TITLE,
+                                   &_speckleWindowSizeSlider,
+                                   _maxSpeckleWindowSize,
+                                   callbackSpecleWindowSizeSlider, this);
+    DisplayManager::createTrackbar(SPECKLE_RANGE_TRACKBAR_TITLE,
+                                   OPTIONS_WINDOW_TITLE,
+                                   &_speckleRangeSlider,
+                                   _maxSpeckleRange,
+                                   callbackSpecleRangeSlider, this);
+    DisplayManager::createTrackbar(SMOOTHNESS_PAR1_TRACKBAR_TITLE,
+                                   OPTIONS_WINDOW_TITLE,
+                                   &_smoothnessPar1Slider,
+                                   _maxSmoothnessPar1,
+                                   callbackSmoothnessPar1Slider, this);
+    DisplayManager::createTrackbar(SMOOTHNESS_PAR2_TRACKBAR_TITLE,
+                                   OPTIONS_WINDOW_TITLE,
+                                   &_smoothnessPar2Slider,
+                                   _maxSmoothnessPar2,
+                                   callbackSmoothnessPar2Slider, this);
+    DisplayManager::createTrackbar(BACKGROUND_REMOVAL_TRACKBAR_TITLE,
+                                   OPTIONS_WINDOW_TITLE,
+                                   &_backgroundRemovalSlider,
+                                   _maxBackgroundRemoval,
+                                   callbackBackgroundRemovalSlider);
+    DisplayManager::createTrackbar(FOREGROUND_REMOVAL_TRACKBAR_TITLE,
+                                   OPTIONS_WINDOW_TITLE,
+                                   &_foregroundRemovalSlider,
+                                   _maxForegroundRemoval,
+                                   callbackForegroundRemovalSlider);
 }
 
 void DisparityProvider::updateMapWindow() noexcept
 {
+    *_workspace.displayImage = _workspace.disparityBlackWhite;
     DisplayManager::showImages(
             {std::make_tuple(DISPARITY_WINDOW_TITLE,
-             std::make_shared<cv::Mat>(_disparityBlackWhite),
+             _workspace.displayImage,
              1)});
 }
 
 void DisparityProvider::showOptionsWindow() noexcept
 {
     MatSharedPtr emptyImage =
-        MatSharedPtr(new cv::Mat(50, _leftImage.size().width, CV_32F));
+        MatSharedPtr(new cv::Mat(50, _workspace.leftImage.size().width, CV_32F));
     DisplayManager::showImages(
         {std::make_tuple(OPTIONS_WINDOW_TITLE,
                          emptyImage,
                          1)});
 }
 
-void DisparityProvider::handleKeyInterruptions() const throw(InterruptedByUser)
+void DisparityProvider::handleKeyInterruptions() throw(InterruptedByUser)
 {
-    while(char pressedKey = cv::waitKey(0))
+    while(true)
     {
+        char pressedKey = DisplayManager::waitKey(WORKER_POLL_INTERVAL);
+        updateFromWorker();
+
         if(pressedKey == SAVE_KEY)
         {
             saveDisparityMap();
+            saveMatcherParameters();
             break;
         }
         else if(pressedKey == ESCAPE_KEY)
@@ -259,6 +504,28 @@ void DisparityProvider::saveDisparityMap() const noexcept
 {
     cv::FileStorage fileStorage(DISPARITY_MAP_OUTPUT_FILE,
                                 cv::FileStorage::WRITE);
-    fileStorage << DISPARITY_MAP_TITLE << _disparityBlackWhite;
+    fileStorage << DISPARITY_MAP_TITLE << _workspace.disparityBlackWhite;
+    fileStorage.release();
+}
+
+void DisparityProvider::saveMatcherParameters() const noexcept
+{
+    cv::FileStorage fileStorage(MATCHER_PARAMETERS_FILE,
+                                cv::FileStorage::WRITE);
+    _sgbmBackend->saveParameters(fileStorage);
+    _bmBackend->saveParameters(fileStorage);
+    _censusBackend->saveParameters(fileStorage);
+    fileStorage.release();
+}
+
+void DisparityProvider::loadMatcherParameters() noexcept
+{
+    cv::FileStorage fileStorage(MATCHER_PARAMETERS_FILE,
+                                cv::FileStorage::READ);
+    if(!fileStorage.isOpened()) return;
+
+    _sgbmBackend->loadParameters(fileStorage);
+    _bmBackend->loadParameters(fileStorage);
+    _censusBackend->loadParameters(fileStorage);
     fileStorage.release();
 }
@@ -3,34 +3,94 @@
 
 #include "DisplayManager.h"
 #include "CommonExceptions.h"
+#include "SGBMBackend.h"
+#include "BMBackend.h"
+#include "CensusBackend.h"
+#include "StereoMatcherBenchmark.h"
+#include "DisparitySequenceRecorder.h"
+#include "Undistorter.h"
+#include "RectifyMapGenerator.h"
+#include "ConfidenceEstimator.h"
+#include "FrameSetReader.h"
+#include "DisparityWorker.h"
+#include "DisparityWorkspace.h"
+#include "AllocationCounter.h"
 
 #include <opencv2/highgui/highgui.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
 #include <opencv2/calib3d/calib3d.hpp>
 
 #include <string>
+#include <vector>
+#include <utility>
+#include <memory>
 
 class DisparityProvider
 {
 public:
     DisparityProvider(std::string& pathToRectifyMaps) noexcept;
+    DisparityProvider(const RectifyMaps& rectifyMaps) noexcept;
 
     void loadRectifyMaps(std::string& pathToRectifyMaps) noexcept;
+    void setRectifyMaps(const RectifyMaps& rectifyMaps) noexcept;
+
+    const cv::Mat& computeDisparityMap(const cv::Mat& leftImage,
+                                       const cv::Mat& rightImage) noexcept;
+    const cv::Mat& confidenceMap() const noexcept
+    { return _workspace.confidence; }
+
+    void enableConfidenceMap(bool leftRightCheck = false) noexcept;
+    void disableConfidenceMap() noexcept;
 
     void computeAndDisplayDisparityMap(std::string& leftImage,
                                        std::string& rightImage) noexcept;
+    void computeAndDisplayDisparityMap(const FrameSetReader& recording,
+                                       int frameSet) noexcept;
 
-private:
-    void prepareImages(std::string& leftImage, std::string& rightImage) noexcept;
+    void useSGBMBackend() noexcept;
+    void useBMBackend() noexcept;
+    void useCensusBackend() noexcept;
 
-    void loadGrayImages(std::string& leftImage, std::string& rightImage)
+    void benchmarkBackends(
+            const std::vector<std::pair<std::string, std::string>>& imagePairs)
         noexcept;
 
-    void remapImages() noexcept;
-    cv::Mat remapImage(cv::Mat& image, cv::Mat& rectifyMapX, cv::Mat& rectifyMapY)
+    void startRecordingDisparityMaps(const std::string& path) noexcept;
+    void stopRecordingDisparityMaps() noexcept;
+
+    void setAllocationCheck(int warmUpFrames) noexcept;
+    int lastFrameAllocations() const noexcept { return _lastAllocations; }
+
+private:
+    DisparityProvider() noexcept;
+
+    bool prepareImages(const std::string& leftImage,
+                       const std::string& rightImage) noexcept;
+
+    void prepareImages(const cv::Mat& leftImage,
+                       const cv::Mat& rightImage) noexcept;
+
+    bool loadGrayImages(const std::string& leftImage,
+                        const std::string& rightImage) noexcept;
+    bool loadGrayImage(const std::string& path, cv::Mat& grayImage) noexcept;
+    const cv::Mat& convertToGray(const cv::Mat& image, cv::Mat& grayImage)
         const noexcept;
 
+    void remapImages() noexcept;
+    void remapImages(const cv::Mat& leftGrayImage,
+                     const cv::Mat& rightGrayImage) noexcept;
+
     void computeDisparityMap() noexcept;
+    void computeRawDisparityMap() noexcept;
+    void normalizeDisparityMap() noexcept;
+    void requestDisparityMap(bool debounce = true) noexcept;
+    void updateFromWorker() noexcept;
+    void computeConfidenceMap() noexcept;
+    void computeRightDisparityMap() noexcept;
+
+    void initUndistorters() noexcept;
+    void startCountingAllocations() noexcept;
+    void checkAllocations() noexcept;
 
     void static callbackMinDisparitySlider(int newValue, void * object);
     void static callbackNumDisparitiesSlider(int newValue, void * object);
@@ -50,25 +110,41 @@ private:
     void updateMapWindow() noexcept;
     void showOptionsWindow() noexcept;
 
-    void handleKeyInterruptions() const throw (InterruptedByUser);
+    void handleKeyInterruptions() throw (InterruptedByUser);
 
     void saveDisparityMap() const noexcept;
 
+    void saveMatcherParameters() const noexcept;
+    void loadMatcherParameters() noexcept;
+
 
 
-    cv::StereoSGBM _stereoSGBMState;
+    StereoMatcherBackendPtr _sgbmBackend;
+    StereoMatcherBackendPtr _bmBackend;
+    StereoMatcherBackendPtr _censusBackend;
+    StereoMatcherBackendPtr _backend;
 
-    cv::Mat _disparity;
-    cv::Mat _disparityBlackWhite;
+    std::shared_ptr<DisparitySequenceRecorder> _recorder;
+    std::unique_ptr<DisparityWorker> _worker;
 
-    cv::Mat _leftImage;
-    cv::Mat _rightImage;
+    DisparityWorkspace _workspace;
+    int _allocationCheckWarmUp = -1;
+    int _checkedFrames         = 0;
+    int _lastAllocations       = 0;
+    uint64_t _allocationsAtFrameStart = 0;
+
+    ConfidenceEstimator _confidenceEstimator;
+    bool _confidenceEnabled = false;
+    bool _leftRightCheck    = false;
 
     cv::Mat _rectifyMapXLeft;
     cv::Mat _rectifyMapYLeft;
     cv::Mat _rectifyMapXRight;
     cv::Mat _rectifyMapYRight;
 
+    Undistorter _leftUndistorter;
+    Undistorter _rightUndistorter;
+
     int _generateSlider               = 0;
     int _minDisparitySlider           = 50;
     int _numDisparitiesSlider         = 48;
@@ -96,6 +172,7 @@ private:
     const int _maxForegroundRemoval   = 255;
 
     const std::string DISPARITY_MAP_OUTPUT_FILE = "disparity_map.yml";
+    const std::string MATCHER_PARAMETERS_FILE = "matcher_parameters.yml";
 
     const std::string DISPARITY_MAP_TITLE   = "Disparity Map";
     const std::string RECTIFY_MAP_X1_TITLE  = "Rectify Map X1";
@@ -106,6 +183,12 @@ private:
     const std::string DISPARITY_WINDOW_TITLE = "Disparity";
     const std::string OPTIONS_WINDOW_TITLE = "Options";
 
+    const std::string IMAGE_LOAD_FAILED = "Could not load image, skipping: ";
+    const std::string ALLOCATION_COUNTER_DISABLED =
+        "Allocation check needs a build with COUNT_ALLOCATIONS";
+    const std::string ALLOCATIONS_AFTER_WARM_UP =
+        "Heap allocations in a warmed-up frame: ";
+
     const std::string MIN_DISPARITY_TRACKBAR_TITLE = "Minimum Disparity";
     const std::string NUM_DISPARITIES_TRACKBAR_TITLE = "Num Disparities";
     const std::string SAD_WINDOWS_SIZE_TRACKBAR_TITLE = "SAD Windows Size";
@@ -120,6 +203,8 @@ private:
     const std::string FOREGROUND_REMOVAL_TRACKBAR_TITLE = "Foreground Removal";
     const std::string GENERATE_SLIDER_TITLE = "Generate";
 
+    const int WORKER_POLL_INTERVAL = 15;
+
     const char SAVE_KEY   = 's';
     const char ESCAPE_KEY = 27;
 };
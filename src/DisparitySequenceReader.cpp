@@ -0,0 +1,93 @@
+#include "DisparitySequenceReader.h"
+
+#include <climits>
+
+DisparitySequenceReader::DisparitySequenceReader(const std::string& path)
+    noexcept
+    : _input(path, std::ifstream::binary)
+{
+    loadIndex();
+}
+
+bool DisparitySequenceReader::read(int frameIndex, cv::Mat& frame) noexcept
+{
+    if(frameIndex < 0 || frameIndex >= framesAmount()) return false;
+
+    const DisparitySequenceEntry& entry = _index[frameIndex];
+    _buffer.resize(entry.size);
+    _input.clear();
+    _input.seekg(entry.offset);
+    _input.read(reinterpret_cast<char*>(_buffer.data()), entry.size);
+    if(!_input) return false;
+
+    cv::Mat decoded = cv::imdecode(_buffer, CV_LOAD_IMAGE_UNCHANGED);
+    if(decoded.empty() || decoded.type() != CV_16UC1) return false;
+
+    cv::Mat(decoded.size(), entry.type, decoded.data, decoded.step)
+        .copyTo(frame);
+    return true;
+}
+
+int DisparitySequenceReader::framesAmount() const noexcept
+{
+    return _index.size();
+}
+
+void DisparitySequenceReader::loadIndex() noexcept
+{
+    uint32_t magic = 0, version = 0, framesAmount = 0, trailerMagic = 0;
+    uint64_t indexOffset = 0;
+    size_t trailerSize = sizeof(indexOffset) + sizeof(framesAmount) +
+                         sizeof(trailerMagic);
+
+    _input.seekg(0, std::ifstream::end);
+    std::streamoff fileSize = _input.tellg();
+    if(!_input || fileSize < static_cast<std::streamoff>(HEADER_SIZE +
+                                                         trailerSize))
+        return;
+
+    _input.seekg(0);
+    _input.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    _input.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if(!_input || magic != FILE_MAGIC || version != FILE_VERSION) return;
+
+    _input.seekg(-static_cast<std::streamoff>(trailerSize),
+                 std::ifstream::end);
+    _input.read(reinterpret_cast<char*>(&indexOffset), sizeof(indexOffset));
+    _input.read(reinterpret_cast<char*>(&framesAmount), sizeof(framesAmount));
+    _input.read(reinterpret_cast<char*>(&trailerMagic), sizeof(trailerMagic));
+
+    uint64_t indexSpace = fileSize - trailerSize;
+    if(!_input || trailerMagic != FILE_MAGIC ||
+       framesAmount > static_cast<uint32_t>(INT_MAX) ||
+       indexOffset < HEADER_SIZE || indexOffset > indexSpace ||
+       framesAmount > (indexSpace - indexOffset) /
+                      sizeof(DisparitySequenceEntry))
+        return;
+
+    _index.resize(framesAmount);
+    _input.seekg(indexOffset);
+    _input.read(reinterpret_cast<char*>(_index.data()),
+                framesAmount * sizeof(DisparitySequenceEntry));
+    if(!_input)
+    {
+        _index.clear();
+        return;
+    }
+
+    for(auto& entry : _index)
+        if(!isValidEntry(entry, indexOffset))
+        {
+            _index.clear();
+            return;
+        }
+}
+
+bool DisparitySequenceReader::isValidEntry(const DisparitySequenceEntry& entry,
+                                           uint64_t indexOffset)
+    const noexcept
+{
+    return entry.offset >= HEADER_SIZE && entry.offset <= indexOffset &&
+           entry.size > 0 && entry.size <= indexOffset - entry.offset &&
+           (entry.type == CV_16SC1 || entry.type == CV_16UC1);
+}
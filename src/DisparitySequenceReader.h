@@ -0,0 +1,40 @@
+#ifndef DISPARITYSEQUENCEREADER_H
+#define DISPARITYSEQUENCEREADER_H
+
+#include "DisparitySequenceRecorder.h"
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/highgui/highgui.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <fstream>
+
+class DisparitySequenceReader
+{
+public:
+    DisparitySequenceReader(const std::string& path) noexcept;
+
+    bool read(int frameIndex, cv::Mat& frame) noexcept;
+
+    int framesAmount() const noexcept;
+
+private:
+    void loadIndex() noexcept;
+    bool isValidEntry(const DisparitySequenceEntry& entry,
+                      uint64_t indexOffset) const noexcept;
+
+
+
+    std::ifstream _input;
+    vector<DisparitySequenceEntry> _index;
+    vector<uchar> _buffer;
+
+    const uint32_t FILE_MAGIC   = 0x31535144;
+    const uint32_t FILE_VERSION = 1;
+
+    static const size_t HEADER_SIZE = 2 * sizeof(uint32_t);
+};
+
+#endif // DISPARITYSEQUENCEREADER_H
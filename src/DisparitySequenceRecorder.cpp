@@ -0,0 +1,107 @@
+#include "DisparitySequenceRecorder.h"
+
+class PngFrameEncoder : public cv::ParallelLoopBody
+{
+public:
+    PngFrameEncoder(const vector<cv::Mat>& frames,
+                    vector<vector<uchar>>& encodedFrames,
+                    int compressionLevel) noexcept
+        : _frames(frames),
+          _encodedFrames(encodedFrames),
+          _compressionLevel(compressionLevel)
+    {
+    }
+
+    void operator()(const cv::Range& range) const
+    {
+        vector<int> parameters = {CV_IMWRITE_PNG_COMPRESSION, _compressionLevel};
+
+        for(int i = range.start; i < range.end; i++)
+        {
+            const cv::Mat& frame = _frames[i];
+            cv::Mat unsignedView(frame.size(), CV_16UC1, frame.data, frame.step);
+            cv::imencode(".png", unsignedView, _encodedFrames[i], parameters);
+        }
+    }
+
+private:
+    const vector<cv::Mat>& _frames;
+    vector<vector<uchar>>& _encodedFrames;
+    const int _compressionLevel;
+};
+
+DisparitySequenceRecorder::DisparitySequenceRecorder(const std::string& path)
+    noexcept
+    : _output(path, std::ofstream::binary | std::ofstream::trunc)
+{
+    uint32_t magic = FILE_MAGIC, version = FILE_VERSION;
+
+    _output.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+    _output.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    _pendingFrames.resize(BATCH_SIZE);
+    _encodedFrames.resize(BATCH_SIZE);
+}
+
+DisparitySequenceRecorder::~DisparitySequenceRecorder() noexcept
+{
+    close();
+}
+
+bool DisparitySequenceRecorder::add(const cv::Mat& frame) noexcept
+{
+    if(!_output.is_open() ||
+       (frame.type() != CV_16SC1 && frame.type() != CV_16UC1))
+        return false;
+
+    frame.copyTo(_pendingFrames[_pendingAmount++]);
+    if(_pendingAmount >= BATCH_SIZE)
+        encodePendingFrames();
+    return true;
+}
+
+void DisparitySequenceRecorder::close() noexcept
+{
+    if(!_output.is_open()) return;
+
+    encodePendingFrames();
+
+    uint64_t indexOffset = _output.tellp();
+    uint32_t framesAmount = _index.size(), magic = FILE_MAGIC;
+
+    _output.write(reinterpret_cast<const char*>(_index.data()),
+                  _index.size() * sizeof(DisparitySequenceEntry));
+    _output.write(reinterpret_cast<const char*>(&indexOffset),
+                  sizeof(indexOffset));
+    _output.write(reinterpret_cast<const char*>(&framesAmount),
+                  sizeof(framesAmount));
+    _output.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+    _output.close();
+}
+
+int DisparitySequenceRecorder::framesAmount() const noexcept
+{
+    return _index.size() + _pendingAmount;
+}
+
+void DisparitySequenceRecorder::encodePendingFrames() noexcept
+{
+    if(_pendingAmount == 0) return;
+
+    cv::parallel_for_(cv::Range(0, _pendingAmount),
+                      PngFrameEncoder(_pendingFrames,
+                                      _encodedFrames,
+                                      PNG_COMPRESSION_LEVEL));
+
+    for(size_t i = 0; i < _pendingAmount; i++)
+    {
+        DisparitySequenceEntry entry;
+        entry.offset = _output.tellp();
+        entry.size = _encodedFrames[i].size();
+        entry.type = _pendingFrames[i].type();
+
+        _output.write(reinterpret_cast<const char*>(_encodedFrames[i].data()),
+                      _encodedFrames[i].size());
+        _index.push_back(entry);
+    }
+    _pendingAmount = 0;
+}
@@ -0,0 +1,49 @@
+#ifndef DISPARITYSEQUENCERECORDER_H
+#define DISPARITYSEQUENCERECORDER_H
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/highgui/highgui.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <fstream>
+
+using std::vector;
+
+struct DisparitySequenceEntry
+{
+    uint64_t offset;
+    uint32_t size;
+    int32_t type;
+};
+
+class DisparitySequenceRecorder
+{
+public:
+    DisparitySequenceRecorder(const std::string& path) noexcept;
+    ~DisparitySequenceRecorder() noexcept;
+
+    bool add(const cv::Mat& frame) noexcept;
+    void close() noexcept;
+
+    int framesAmount() const noexcept;
+
+private:
+    void encodePendingFrames() noexcept;
+
+
+
+    std::ofstream _output;
+    vector<cv::Mat> _pendingFrames;
+    size_t _pendingAmount = 0;
+    vector<vector<uchar>> _encodedFrames;
+    vector<DisparitySequenceEntry> _index;
+
+    const uint32_t FILE_MAGIC   = 0x31535144;
+    const uint32_t FILE_VERSION = 1;
+    const int PNG_COMPRESSION_LEVEL = 1;
+    const size_t BATCH_SIZE = 16;
+};
+
+#endif // DISPARITYSEQUENCERECORDER_H
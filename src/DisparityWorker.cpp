@@ -0,0 +1,160 @@
+#include "DisparityWorker.h"
+
+#include <algorithm>
+
+DisparityWorker::DisparityWorker() noexcept
+    : _backends({std::make_shared<SGBMBackend>(),
+                 std::make_shared<BMBackend>(),
+                 std::make_shared<CensusBackend>()}),
+      _latestRequestId(0)
+{
+    _thread = std::thread(&DisparityWorker::run, this);
+}
+
+DisparityWorker::~DisparityWorker() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+        _latestRequestId++;
+    }
+    _condition.notify_one();
+    _thread.join();
+}
+
+void DisparityWorker::request(const std::string& backendName,
+                              const StereoMatcherParameters& parameters,
+                              const cv::Mat& leftImage,
+                              const cv::Mat& rightImage,
+                              bool debounce) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending.id = ++_latestRequestId;
+        _pending.backendName = backendName;
+        _pending.parameters = parameters;
+        leftImage.copyTo(_pending.leftImage);
+        rightImage.copyTo(_pending.rightImage);
+        _pending.startTime = std::chrono::steady_clock::now() +
+                             (debounce ? _debounceTime
+                                       : std::chrono::milliseconds(0));
+        _hasPending = true;
+    }
+    _condition.notify_one();
+}
+
+bool DisparityWorker::takeResult(cv::Mat& disparity, bool& isFinal) noexcept
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if(!_hasResult) return false;
+
+    std::swap(disparity, _result);
+    isFinal = _isResultFinal;
+    _hasResult = false;
+    return true;
+}
+
+void DisparityWorker::setDebounceTime(int milliseconds) noexcept
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _debounceTime = std::chrono::milliseconds(milliseconds);
+}
+
+void DisparityWorker::run() noexcept
+{
+    DisparityRequest request;
+
+    while(waitForRequest(request))
+        process(request);
+}
+
+bool DisparityWorker::waitForRequest(DisparityRequest& request) noexcept
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while(!_stopping)
+    {
+        if(!_hasPending)
+            _condition.wait(lock);
+        else if(std::chrono::steady_clock::now() < _pending.startTime)
+            _condition.wait_until(lock, _pending.startTime);
+        else
+        {
+            request.id = _pending.id;
+            request.backendName = _pending.backendName;
+            request.parameters = _pending.parameters;
+            request.startTime = _pending.startTime;
+            std::swap(request.leftImage, _pending.leftImage);
+            std::swap(request.rightImage, _pending.rightImage);
+            _hasPending = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+void DisparityWorker::process(const DisparityRequest& request) noexcept
+{
+    StereoMatcherBackend* matcher = backend(request.backendName);
+    if(!matcher || request.leftImage.empty()) return;
+
+    if(request.leftImage.total() >= static_cast<size_t>(PREVIEW_MIN_PIXELS))
+    {
+        computePreview(request, *matcher);
+        if(isCancelled(request)) return;
+    }
+
+    matcher->parameters() = request.parameters;
+    matcher->compute(request.leftImage, request.rightImage, _disparity);
+    if(!isCancelled(request))
+        publish(request, _disparity, true);
+}
+
+void DisparityWorker::computePreview(const DisparityRequest& request,
+                                     StereoMatcherBackend& backend) noexcept
+{
+    StereoMatcherParameters& parameters = backend.parameters();
+
+    parameters = request.parameters;
+    parameters.minDisparity = request.parameters.minDisparity / 2;
+    parameters.numberOfDisparities =
+        std::max(DISPARITY_STEP,
+                 request.parameters.numberOfDisparities / 2 /
+                 DISPARITY_STEP * DISPARITY_STEP);
+
+    cv::pyrDown(request.leftImage, _previewLeft);
+    cv::pyrDown(request.rightImage, _previewRight);
+    backend.compute(_previewLeft, _previewRight, _previewDisparity);
+    if(isCancelled(request)) return;
+
+    cv::resize(_previewDisparity, _disparity, request.leftImage.size(),
+               0, 0, cv::INTER_NEAREST);
+    _disparity.convertTo(_disparity, CV_16S, 2);
+    publish(request, _disparity, false);
+}
+
+bool DisparityWorker::isCancelled(const DisparityRequest& request)
+    const noexcept
+{
+    return _latestRequestId.load() != request.id;
+}
+
+void DisparityWorker::publish(const DisparityRequest& request,
+                              const cv::Mat& disparity,
+                              bool isFinal) noexcept
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if(_latestRequestId.load() != request.id) return;
+
+    disparity.copyTo(_result);
+    _isResultFinal = isFinal;
+    _hasResult = true;
+}
+
+StereoMatcherBackend* DisparityWorker::backend(const std::string& name)
+    noexcept
+{
+    for(auto& backend : _backends)
+        if(backend->name() == name) return backend.get();
+    return nullptr;
+}
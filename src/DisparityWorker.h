@@ -0,0 +1,89 @@
+#ifndef DISPARITYWORKER_H
+#define DISPARITYWORKER_H
+
+#include "SGBMBackend.h"
+#include "BMBackend.h"
+#include "CensusBackend.h"
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct DisparityRequest
+{
+    uint64_t id = 0;
+    std::string backendName;
+    StereoMatcherParameters parameters;
+    cv::Mat leftImage;
+    cv::Mat rightImage;
+    std::chrono::steady_clock::time_point startTime;
+};
+
+class DisparityWorker
+{
+public:
+    DisparityWorker() noexcept;
+    ~DisparityWorker() noexcept;
+
+    DisparityWorker(const DisparityWorker&) = delete;
+    DisparityWorker& operator=(const DisparityWorker&) = delete;
+
+    void request(const std::string& backendName,
+                 const StereoMatcherParameters& parameters,
+                 const cv::Mat& leftImage,
+                 const cv::Mat& rightImage,
+                 bool debounce = true) noexcept;
+    bool takeResult(cv::Mat& disparity, bool& isFinal) noexcept;
+
+    void setDebounceTime(int milliseconds) noexcept;
+
+private:
+    void run() noexcept;
+    bool waitForRequest(DisparityRequest& request) noexcept;
+    void process(const DisparityRequest& request) noexcept;
+    void computePreview(const DisparityRequest& request,
+                        StereoMatcherBackend& backend) noexcept;
+    bool isCancelled(const DisparityRequest& request) const noexcept;
+    void publish(const DisparityRequest& request,
+                 const cv::Mat& disparity,
+                 bool isFinal) noexcept;
+    StereoMatcherBackend* backend(const std::string& name) noexcept;
+
+
+
+    std::vector<StereoMatcherBackendPtr> _backends;
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::thread _thread;
+
+    DisparityRequest _pending;
+    bool _hasPending = false;
+    bool _stopping   = false;
+    std::atomic<uint64_t> _latestRequestId;
+
+    cv::Mat _result;
+    bool _hasResult     = false;
+    bool _isResultFinal = false;
+
+    cv::Mat _previewLeft;
+    cv::Mat _previewRight;
+    cv::Mat _previewDisparity;
+    cv::Mat _disparity;
+
+    std::chrono::milliseconds _debounceTime = std::chrono::milliseconds(150);
+
+    const int PREVIEW_MIN_PIXELS = 2000000;
+    const int DISPARITY_SCALE    = 16;
+    const int DISPARITY_STEP     = 16;
+};
+
+#endif // DISPARITYWORKER_H
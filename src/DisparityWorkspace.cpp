@@ -0,0 +1,30 @@
+#include "DisparityWorkspace.h"
+
+#include <fstream>
+
+void DisparityWorkspace::reserve(const cv::Size& imageSize) noexcept
+{
+    for(cv::Mat* image : {&leftGrayImage, &rightGrayImage,
+                          &leftImage, &rightImage,
+                          &flippedLeftImage, &flippedRightImage,
+                          &disparityBlackWhite, &mask,
+                          &uniqueness, &confidence})
+        image->create(imageSize, CV_8U);
+
+    for(cv::Mat* image : {&disparity, &flippedDisparity, &rightDisparity})
+        image->create(imageSize, CV_16S);
+}
+
+bool DisparityWorkspace::loadFile(const std::string& path) noexcept
+{
+    std::ifstream input(path, std::ifstream::binary | std::ifstream::ate);
+    if(!input) return false;
+
+    std::streamsize size = input.tellg();
+    input.seekg(0);
+    if(fileBuffer.capacity() < static_cast<size_t>(size))
+        fileBuffer.reserve(size * 2);
+    fileBuffer.resize(size);
+    return static_cast<bool>(
+        input.read(reinterpret_cast<char*>(fileBuffer.data()), size));
+}
@@ -0,0 +1,37 @@
+#ifndef DISPARITYWORKSPACE_H
+#define DISPARITYWORKSPACE_H
+
+#include <opencv2/core/core.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using MatSharedPtr = std::shared_ptr<cv::Mat>;
+
+struct DisparityWorkspace
+{
+    void reserve(const cv::Size& imageSize) noexcept;
+    bool loadFile(const std::string& path) noexcept;
+
+    cv::Mat leftGrayImage;
+    cv::Mat rightGrayImage;
+    cv::Mat leftImage;
+    cv::Mat rightImage;
+
+    cv::Mat disparity;
+    cv::Mat disparityBlackWhite;
+    cv::Mat mask;
+    MatSharedPtr displayImage = std::make_shared<cv::Mat>();
+
+    cv::Mat uniqueness;
+    cv::Mat flippedLeftImage;
+    cv::Mat flippedRightImage;
+    cv::Mat flippedDisparity;
+    cv::Mat rightDisparity;
+    cv::Mat confidence;
+
+    std::vector<uchar> fileBuffer;
+};
+
+#endif // DISPARITYWORKSPACE_H
@@ -1,20 +1,58 @@
 #include "DisplayManager.h"
 
+#include <algorithm>
+
 vector<std::string> DisplayManager::_openedWindows = vector<std::string>();
 
+std::mutex DisplayManager::_mutex;
+std::condition_variable DisplayManager::_keyCondition;
+std::map<std::string, DisplaySlot> DisplayManager::_slots;
+vector<std::pair<const std::string, DisplaySlot>*>
+    DisplayManager::_slotsToDraw;
+vector<std::function<void()>> DisplayManager::_commands;
+vector<std::function<void()>> DisplayManager::_callbacks;
+std::deque<int> DisplayManager::_keys;
+std::map<TrackbarKey, TrackbarBinding> DisplayManager::_trackbars;
+std::atomic<bool> DisplayManager::_stopping(false);
+std::chrono::milliseconds DisplayManager::_frameInterval =
+    std::chrono::milliseconds(1000 / DEFAULT_MAX_FRAME_RATE);
+
+DisplayManager::DisplayThread DisplayManager::_displayThread;
+
 DisplayManager::DisplayManager() noexcept
 {
 }
 
+DisplayManager::DisplayThread::~DisplayThread() noexcept
+{
+    stop();
+}
+
+void DisplayManager::DisplayThread::start() noexcept
+{
+    if(!_thread.joinable())
+        _thread = std::thread(&DisplayManager::run);
+}
+
+void DisplayManager::DisplayThread::stop() noexcept
+{
+    _stopping = true;
+    if(_thread.joinable()) _thread.join();
+}
+
 void DisplayManager::showImages(
         const std::initializer_list
             <std::tuple<const std::string, const MatSharedPtr, const int>>
             &imagesWithWindowsNamesAndTimesToShow) noexcept
 {
-    for(auto image : imagesWithWindowsNamesAndTimesToShow)
+    std::lock_guard<std::mutex> lock(_mutex);
+    _displayThread.start();
+
+    for(auto& image : imagesWithWindowsNamesAndTimesToShow)
     {
-        cv::imshow(std::get<0>(image).c_str(), *std::get<1>(image));
-        cv::waitKey(std::get<2>(image));
+        DisplaySlot& slot = _slots[std::get<0>(image)];
+        std::get<1>(image)->copyTo(slot.latestImage);
+        slot.isDirty = true;
     }
 }
 
@@ -24,7 +62,7 @@ void DisplayManager::createWindows(const std::initializer_list
     for(auto name : names)
         if (isOpened(name))
         {
-            cv::namedWindow(name.c_str());
+            post([name]() { cv::namedWindow(name.c_str()); });
             _openedWindows.push_back(name);
         }
 }
@@ -46,9 +84,231 @@ void DisplayManager::destroyWindows(const std::initializer_list
     for(auto name : names)
         if (isOpened(name))
         {
-            cv::destroyWindow(name.c_str());
+            post([name]()
+            {
+                cv::destroyWindow(name.c_str());
+                std::lock_guard<std::mutex> lock(_mutex);
+                _slots.erase(name);
+                eraseTrackbars(name);
+            });
             _openedWindows.erase(std::remove(
                 _openedWindows.begin(), _openedWindows.end(), name),
                 _openedWindows.end());
         }
 }
+
+void DisplayManager::destroyAllWindows() noexcept
+{
+    post([]()
+    {
+        cv::destroyAllWindows();
+        std::lock_guard<std::mutex> lock(_mutex);
+        _slots.clear();
+        _trackbars.clear();
+    });
+    _openedWindows.clear();
+}
+
+void DisplayManager::createTrackbar(const std::string& trackbarName,
+                                    const std::string& windowName,
+                                    int* value,
+                                    int count,
+                                    cv::TrackbarCallback onChange,
+                                    void* userData) noexcept
+{
+    TrackbarBinding binding = {*value, value, onChange, userData};
+
+    post([trackbarName, windowName, count, binding]()
+    {
+        TrackbarKey key(windowName, trackbarName);
+        std::pair<const TrackbarKey, TrackbarBinding>* trackbar;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _trackbars[key] = binding;
+            trackbar = &*_trackbars.find(key);
+        }
+        cv::namedWindow(windowName);
+        cv::createTrackbar(trackbarName, windowName,
+                           &trackbar->second.position, count,
+                           onTrackbarChange,
+                           const_cast<TrackbarKey*>(&trackbar->first));
+    });
+}
+
+void DisplayManager::setTrackbarPos(const std::string& trackbarName,
+                                    const std::string& windowName,
+                                    int position) noexcept
+{
+    post([trackbarName, windowName, position]()
+    {
+        cv::setTrackbarPos(trackbarName, windowName, position);
+    });
+}
+
+void DisplayManager::onTrackbarChange(int newValue, void* key)
+{
+    TrackbarKey trackbarKey = *static_cast<const TrackbarKey*>(key);
+
+    postCallback([trackbarKey, newValue]()
+    {
+        TrackbarBinding binding;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto trackbar = _trackbars.find(trackbarKey);
+            if(trackbar == _trackbars.end()) return;
+            binding = trackbar->second;
+        }
+
+        *binding.value = newValue;
+        if(binding.onChange)
+            binding.onChange(newValue, binding.userData);
+    });
+}
+
+void DisplayManager::eraseTrackbars(const std::string& windowName) noexcept
+{
+    auto trackbar = _trackbars.lower_bound(TrackbarKey(windowName, ""));
+    while(trackbar != _trackbars.end() && trackbar->first.first == windowName)
+        trackbar = _trackbars.erase(trackbar);
+}
+
+int DisplayManager::waitKey(int delay) noexcept
+{
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(delay);
+    std::unique_lock<std::mutex> lock(_mutex);
+    _displayThread.start();
+
+    while(true)
+    {
+        if(!_callbacks.empty())
+        {
+            lock.unlock();
+            runCallbacks();
+            lock.lock();
+        }
+        else if(!_keys.empty())
+        {
+            int key = _keys.front();
+            _keys.pop_front();
+            return key;
+        }
+        else if(delay <= 0)
+            _keyCondition.wait(lock);
+        else if(_keyCondition.wait_until(lock, deadline) ==
+                std::cv_status::timeout &&
+                _callbacks.empty() && _keys.empty())
+            return -1;
+    }
+}
+
+int DisplayManager::pollKey() noexcept
+{
+    runCallbacks();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if(_keys.empty()) return -1;
+
+    int key = _keys.front();
+    _keys.pop_front();
+    return key;
+}
+
+void DisplayManager::setMaxFrameRate(int framesPerSecond) noexcept
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _frameInterval =
+        std::chrono::milliseconds(1000 / std::max(1, framesPerSecond));
+}
+
+void DisplayManager::run() noexcept
+{
+    auto nextDrawTime = std::chrono::steady_clock::now();
+
+    while(!_stopping)
+    {
+        runCommands();
+
+        auto now = std::chrono::steady_clock::now();
+        if(now >= nextDrawTime)
+        {
+            drawLatestImages();
+            std::lock_guard<std::mutex> lock(_mutex);
+            nextDrawTime = now + _frameInterval;
+        }
+
+        auto waitTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            nextDrawTime - std::chrono::steady_clock::now());
+        int key = cv::waitKey(std::max<int>(1, waitTime.count()));
+        if(key >= 0) pushKey(key);
+    }
+}
+
+void DisplayManager::runCommands() noexcept
+{
+    vector<std::function<void()>> commands;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        commands.swap(_commands);
+    }
+
+    for(auto& command : commands)
+        command();
+}
+
+void DisplayManager::drawLatestImages() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _slotsToDraw.clear();
+        for(auto& slot : _slots)
+            if(slot.second.isDirty)
+            {
+                std::swap(slot.second.latestImage, slot.second.shownImage);
+                slot.second.isDirty = false;
+                _slotsToDraw.push_back(&slot);
+            }
+    }
+
+    for(auto slot : _slotsToDraw)
+        cv::imshow(slot->first.c_str(), slot->second.shownImage);
+}
+
+void DisplayManager::pushKey(int key) noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(_keys.size() >= MAX_QUEUED_KEYS) _keys.pop_front();
+        _keys.push_back(key);
+    }
+    _keyCondition.notify_all();
+}
+
+void DisplayManager::runCallbacks() noexcept
+{
+    vector<std::function<void()>> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        callbacks.swap(_callbacks);
+    }
+
+    for(auto& callback : callbacks)
+        callback();
+}
+
+void DisplayManager::post(const std::function<void()>& command) noexcept
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _displayThread.start();
+    _commands.push_back(command);
+}
+
+void DisplayManager::postCallback(const std::function<void()>& callback)
+    noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _callbacks.push_back(callback);
+    }
+    _keyCondition.notify_all();
+}
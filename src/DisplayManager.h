@@ -8,11 +8,36 @@
 #include <utility>
 #include <initializer_list>
 #include <memory>
+#include <map>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <thread>
+#include <chrono>
 
 using std::vector;
 
 using MatSharedPtr = std::shared_ptr<cv::Mat>;
 
+struct DisplaySlot
+{
+    cv::Mat latestImage;
+    cv::Mat shownImage;
+    bool isDirty = false;
+};
+
+struct TrackbarBinding
+{
+    int position;
+    int* value;
+    cv::TrackbarCallback onChange;
+    void* userData;
+};
+
+using TrackbarKey = std::pair<std::string, std::string>;
+
 class DisplayManager
 {
 public:
@@ -29,14 +54,70 @@ public:
 
     static void destroyWindows(const std::initializer_list
                                <const std::string> &names) noexcept;
+    static void destroyAllWindows() noexcept;
 
     static bool isOpened(const std::string name) noexcept;
 
+    static void createTrackbar(const std::string& trackbarName,
+                               const std::string& windowName,
+                               int* value,
+                               int count,
+                               cv::TrackbarCallback onChange = nullptr,
+                               void* userData = nullptr) noexcept;
+    static void setTrackbarPos(const std::string& trackbarName,
+                               const std::string& windowName,
+                               int position) noexcept;
+
+    static int waitKey(int delay) noexcept;
+    static int pollKey() noexcept;
+
+    static void setMaxFrameRate(int framesPerSecond) noexcept;
+
 private:
+    class DisplayThread
+    {
+    public:
+        ~DisplayThread() noexcept;
+
+        void start() noexcept;
+        void stop() noexcept;
+
+    private:
+        std::thread _thread;
+    };
+
+    static void run() noexcept;
+    static void runCommands() noexcept;
+    static void drawLatestImages() noexcept;
+    static void pushKey(int key) noexcept;
+    static void runCallbacks() noexcept;
+    static void onTrackbarChange(int newValue, void* key);
+    static void eraseTrackbars(const std::string& windowName) noexcept;
+
+    static void post(const std::function<void()>& command) noexcept;
+    static void postCallback(const std::function<void()>& callback) noexcept;
+
+
+
     static vector<std::string> _openedWindows;
+
+    static std::mutex _mutex;
+    static std::condition_variable _keyCondition;
+    static std::map<std::string, DisplaySlot> _slots;
+    static vector<std::pair<const std::string, DisplaySlot>*> _slotsToDraw;
+    static vector<std::function<void()>> _commands;
+    static vector<std::function<void()>> _callbacks;
+    static std::deque<int> _keys;
+    static std::map<TrackbarKey, TrackbarBinding> _trackbars;
+    static std::atomic<bool> _stopping;
+    static std::chrono::milliseconds _frameInterval;
+
+    static const int DEFAULT_MAX_FRAME_RATE = 30;
+    static const size_t MAX_QUEUED_KEYS = 16;
+
+    static DisplayThread _displayThread;
 };
 
 
 
 #endif /* DISPLAYMANAGER_H_ */
-
@@ -0,0 +1,143 @@
+#include "FrameSetReader.h"
+
+#include <cstring>
+#include <climits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+FrameSetReader::FrameSetReader(const std::string& path) noexcept
+{
+    int descriptor = open(path.c_str(), O_RDONLY);
+    if(descriptor < 0) return;
+
+    struct stat status;
+    if(fstat(descriptor, &status) == 0 && status.st_size > 0)
+    {
+        void* mapping = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED,
+                             descriptor, 0);
+        if(mapping != MAP_FAILED)
+        {
+            _mapping = static_cast<uint8_t*>(mapping);
+            _mappingSize = status.st_size;
+        }
+    }
+    ::close(descriptor);
+
+    if(_mapping && !loadIndex()) close();
+}
+
+FrameSetReader::~FrameSetReader() noexcept
+{
+    close();
+}
+
+bool FrameSetReader::read(int frameSet, int camera, cv::Mat& frame)
+    const noexcept
+{
+    if(!_mapping || frameSet < 0 || frameSet >= _framesAmount ||
+       camera < 0 || camera >= _camerasAmount)
+        return false;
+
+    const FrameSetEntry& entry = _index[frameSet * _camerasAmount + camera];
+    uint8_t* data = _mapping + entry.offset;
+
+    if(_encoding == FrameEncoding::PNG)
+    {
+        frame = cv::imdecode(cv::Mat(1, entry.size, CV_8U, data),
+                             CV_LOAD_IMAGE_UNCHANGED);
+        return !frame.empty();
+    }
+    frame = cv::Mat(entry.rows, entry.cols, entry.type, data);
+    return true;
+}
+
+bool FrameSetReader::read(int frameSet, vector<cv::Mat>& frames)
+    const noexcept
+{
+    frames.resize(_camerasAmount);
+    for(int camera = 0; camera < _camerasAmount; camera++)
+        if(!read(frameSet, camera, frames[camera])) return false;
+    return true;
+}
+
+int64_t FrameSetReader::timestamp(int frameSet) const noexcept
+{
+    if(frameSet < 0 || frameSet >= _framesAmount) return 0;
+    return _index[frameSet * _camerasAmount].timestamp;
+}
+
+bool FrameSetReader::loadIndex() noexcept
+{
+    uint32_t header[4], framesAmount = 0, trailerMagic = 0;
+    uint64_t indexOffset = 0;
+    size_t trailerSize = sizeof(indexOffset) + sizeof(framesAmount) +
+                         sizeof(trailerMagic);
+
+    if(_mappingSize < sizeof(header) + trailerSize) return false;
+
+    std::memcpy(header, _mapping, sizeof(header));
+    if(header[0] != FrameSetRecorder::FILE_MAGIC ||
+       header[1] != FrameSetRecorder::FILE_VERSION || header[2] == 0)
+        return false;
+
+    const uint8_t* trailer = _mapping + _mappingSize - trailerSize;
+    std::memcpy(&indexOffset, trailer, sizeof(indexOffset));
+    std::memcpy(&framesAmount, trailer + sizeof(indexOffset),
+                sizeof(framesAmount));
+    std::memcpy(&trailerMagic,
+                trailer + sizeof(indexOffset) + sizeof(framesAmount),
+                sizeof(trailerMagic));
+
+    uint64_t entriesAmount = static_cast<uint64_t>(framesAmount) * header[2];
+    uint64_t indexSpace = _mappingSize - trailerSize;
+    if(trailerMagic != FrameSetRecorder::FILE_MAGIC ||
+       header[2] > static_cast<uint32_t>(INT_MAX) ||
+       framesAmount > static_cast<uint32_t>(INT_MAX) ||
+       (header[3] != static_cast<uint32_t>(FrameEncoding::RAW) &&
+        header[3] != static_cast<uint32_t>(FrameEncoding::PNG)) ||
+       indexOffset < HEADER_SIZE || indexOffset > indexSpace ||
+       indexOffset % alignof(FrameSetEntry) != 0 ||
+       entriesAmount > (indexSpace - indexOffset) / sizeof(FrameSetEntry))
+        return false;
+
+    _index = reinterpret_cast<const FrameSetEntry*>(_mapping + indexOffset);
+    _encoding = static_cast<FrameEncoding>(header[3]);
+    for(uint64_t entry = 0; entry < entriesAmount; entry++)
+        if(!isValidEntry(_index[entry], indexOffset)) return false;
+
+    _framesAmount = framesAmount;
+    _camerasAmount = header[2];
+    return true;
+}
+
+bool FrameSetReader::isValidEntry(const FrameSetEntry& entry,
+                                  uint64_t indexOffset) const noexcept
+{
+    if(entry.offset < HEADER_SIZE || entry.offset > indexOffset ||
+       entry.size > indexOffset - entry.offset)
+        return false;
+    if(_encoding == FrameEncoding::PNG) return entry.size > 0;
+
+    if(entry.rows < 0 || entry.cols < 0 || entry.type < 0 ||
+       CV_MAT_DEPTH(entry.type) >= CV_USRTYPE1 ||
+       entry.type >= CV_MAKETYPE(CV_USRTYPE1, CV_CN_MAX))
+        return false;
+
+    uint64_t rowSize = static_cast<uint64_t>(entry.cols) *
+                       CV_ELEM_SIZE(entry.type);
+    return rowSize == 0 || static_cast<uint64_t>(entry.rows) <=
+                           entry.size / rowSize;
+}
+
+void FrameSetReader::close() noexcept
+{
+    if(!_mapping) return;
+
+    munmap(_mapping, _mappingSize);
+    _mapping = nullptr;
+    _index = nullptr;
+    _framesAmount = 0;
+}
@@ -0,0 +1,50 @@
+#ifndef FRAMESETREADER_H
+#define FRAMESETREADER_H
+
+#include "FrameSetRecorder.h"
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/highgui/highgui.hpp>
+
+#include <cstdint>
+#include <string>
+
+class FrameSetReader
+{
+public:
+    FrameSetReader(const std::string& path) noexcept;
+    ~FrameSetReader() noexcept;
+
+    FrameSetReader(const FrameSetReader&) = delete;
+    FrameSetReader& operator=(const FrameSetReader&) = delete;
+
+    bool read(int frameSet, int camera, cv::Mat& frame) const noexcept;
+    bool read(int frameSet, vector<cv::Mat>& frames) const noexcept;
+    int64_t timestamp(int frameSet) const noexcept;
+
+    bool isOpen() const noexcept { return _mapping != nullptr; }
+    bool isZeroCopy() const noexcept
+    { return _encoding == FrameEncoding::RAW; }
+    int framesAmount() const noexcept { return _framesAmount; }
+    int camerasAmount() const noexcept { return _camerasAmount; }
+
+private:
+    bool loadIndex() noexcept;
+    bool isValidEntry(const FrameSetEntry& entry, uint64_t indexOffset)
+        const noexcept;
+    void close() noexcept;
+
+
+
+    uint8_t* _mapping = nullptr;
+    size_t _mappingSize = 0;
+    const FrameSetEntry* _index = nullptr;
+
+    int _framesAmount = 0;
+    int _camerasAmount = 0;
+    FrameEncoding _encoding = FrameEncoding::RAW;
+
+    static const size_t HEADER_SIZE = 4 * sizeof(uint32_t);
+};
+
+#endif // FRAMESETREADER_H
@@ -0,0 +1,119 @@
+#include "FrameSetRecorder.h"
+
+FrameSetRecorder::FrameSetRecorder(const std::string& path,
+                                   int camerasAmount,
+                                   FrameEncoding encoding) noexcept
+    : _camerasAmount(std::max(camerasAmount, 0)),
+      _encoding(encoding)
+{
+    if(_camerasAmount == 0)
+    {
+        std::cerr << NO_CAMERAS << path << std::endl;
+        return;
+    }
+
+    _output.open(path, std::ofstream::binary | std::ofstream::trunc);
+    uint32_t magic = FILE_MAGIC, version = FILE_VERSION;
+    uint32_t encodingValue = static_cast<uint32_t>(_encoding);
+
+    _output.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+    _output.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    _output.write(reinterpret_cast<const char*>(&_camerasAmount),
+                  sizeof(_camerasAmount));
+    _output.write(reinterpret_cast<const char*>(&encodingValue),
+                  sizeof(encodingValue));
+}
+
+FrameSetRecorder::~FrameSetRecorder() noexcept
+{
+    close();
+}
+
+bool FrameSetRecorder::add(const vector<cv::Mat>& frames, int64_t timestamp)
+    noexcept
+{
+    if(!_output.is_open() || frames.size() != _camerasAmount) return false;
+
+    for(auto& frame : frames)
+        if(frame.empty()) return false;
+
+    for(auto& frame : frames)
+        writeFrame(frame, timestamp);
+    return static_cast<bool>(_output);
+}
+
+void FrameSetRecorder::close() noexcept
+{
+    if(!_output.is_open()) return;
+
+    writePadding();
+    uint64_t indexOffset = _output.tellp();
+    uint32_t framesAmount = _index.size() / _camerasAmount, magic = FILE_MAGIC;
+
+    _output.write(reinterpret_cast<const char*>(_index.data()),
+                  _index.size() * sizeof(FrameSetEntry));
+    _output.write(reinterpret_cast<const char*>(&indexOffset),
+                  sizeof(indexOffset));
+    _output.write(reinterpret_cast<const char*>(&framesAmount),
+                  sizeof(framesAmount));
+    _output.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+    _output.close();
+}
+
+int FrameSetRecorder::framesAmount() const noexcept
+{
+    if(_camerasAmount == 0) return 0;
+    return _index.size() / _camerasAmount;
+}
+
+void FrameSetRecorder::writeFrame(const cv::Mat& frame, int64_t timestamp)
+    noexcept
+{
+    writePadding();
+
+    FrameSetEntry entry;
+    entry.offset = _output.tellp();
+    entry.rows = frame.rows;
+    entry.cols = frame.cols;
+    entry.type = frame.type();
+    entry.timestamp = timestamp;
+
+    if(_encoding == FrameEncoding::PNG)
+    {
+        vector<int> parameters = {CV_IMWRITE_PNG_COMPRESSION,
+                                  PNG_COMPRESSION_LEVEL};
+        cv::imencode(".png", frame, _encodedFrame, parameters);
+        _output.write(reinterpret_cast<const char*>(_encodedFrame.data()),
+                      _encodedFrame.size());
+        entry.size = _encodedFrame.size();
+    }
+    else
+    {
+        writeRawFrame(frame);
+        entry.size = frame.total() * frame.elemSize();
+    }
+    _index.push_back(entry);
+}
+
+void FrameSetRecorder::writeRawFrame(const cv::Mat& frame) noexcept
+{
+    size_t rowSize = frame.cols * frame.elemSize();
+
+    if(frame.isContinuous())
+        _output.write(reinterpret_cast<const char*>(frame.data),
+                      rowSize * frame.rows);
+    else
+        for(int row = 0; row < frame.rows; row++)
+            _output.write(reinterpret_cast<const char*>(frame.ptr(row)),
+                          rowSize);
+}
+
+void FrameSetRecorder::writePadding() noexcept
+{
+    static const char zeros[FRAME_ALIGNMENT] = {};
+    size_t position = _output.tellp();
+    size_t padding = (FRAME_ALIGNMENT - position % FRAME_ALIGNMENT) %
+                     FRAME_ALIGNMENT;
+
+    _output.write(zeros, padding);
+}
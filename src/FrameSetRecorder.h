@@ -0,0 +1,64 @@
+#ifndef FRAMESETRECORDER_H
+#define FRAMESETRECORDER_H
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/highgui/highgui.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+using std::vector;
+
+enum class FrameEncoding : uint32_t { RAW = 0, PNG = 1 };
+
+struct FrameSetEntry
+{
+    uint64_t offset;
+    uint32_t size;
+    int32_t rows;
+    int32_t cols;
+    int32_t type;
+    int64_t timestamp;
+};
+
+class FrameSetRecorder
+{
+public:
+    FrameSetRecorder(const std::string& path,
+                     int camerasAmount,
+                     FrameEncoding encoding = FrameEncoding::RAW) noexcept;
+    ~FrameSetRecorder() noexcept;
+
+    bool add(const vector<cv::Mat>& frames, int64_t timestamp) noexcept;
+    void close() noexcept;
+
+    int framesAmount() const noexcept;
+
+    static const uint32_t FILE_MAGIC   = 0x53534652;
+    static const uint32_t FILE_VERSION = 1;
+    static const size_t FRAME_ALIGNMENT = 64;
+
+private:
+    void writeFrame(const cv::Mat& frame, int64_t timestamp) noexcept;
+    void writeRawFrame(const cv::Mat& frame) noexcept;
+    void writePadding() noexcept;
+
+
+
+    std::ofstream _output;
+    vector<FrameSetEntry> _index;
+    vector<uchar> _encodedFrame;
+
+    const uint32_t _camerasAmount;
+    const FrameEncoding _encoding;
+
+    const int PNG_COMPRESSION_LEVEL = 1;
+
+    const std::string NO_CAMERAS = "Cannot record without cameras: ";
+};
+
+#endif // FRAMESETRECORDER_H
@@ -0,0 +1,114 @@
+#include "FrameSource.h"
+
+#include <cstdlib>
+#include <map>
+#include <mutex>
+
+const std::string FrameSource::RECORDING_EXTENSION = ".frames";
+
+static std::shared_ptr<FrameSetReader> sharedRecording(const std::string& path)
+{
+    static std::mutex mutex;
+    static std::map<std::string, std::shared_ptr<FrameSetReader>> recordings;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& recording = recordings[path];
+    if(!recording || !recording->isOpen())
+        recording = std::make_shared<FrameSetReader>(path);
+    return recording;
+}
+
+FrameSource::FrameSource(const std::string& source) noexcept
+{
+    open(source);
+}
+
+bool FrameSource::open(const std::string& source) noexcept
+{
+    release();
+    if(!isRecording(source))
+        return _capture.open(source);
+
+    size_t separator = source.rfind(CAMERA_SEPARATOR);
+    std::string path = source;
+    if(separator != std::string::npos &&
+       separator > source.rfind(RECORDING_EXTENSION))
+    {
+        path = source.substr(0, separator);
+        _camera = std::atoi(source.c_str() + separator + 1);
+    }
+
+    _recording = sharedRecording(path);
+    return isOpened();
+}
+
+bool FrameSource::isOpened() const noexcept
+{
+    if(_recording)
+        return _recording->isOpen() && _camera < _recording->camerasAmount();
+    return _capture.isOpened();
+}
+
+void FrameSource::release() noexcept
+{
+    _capture.release();
+    _recording.reset();
+    _camera = 0;
+    _position = 0;
+}
+
+bool FrameSource::grab() noexcept
+{
+    if(!_recording) return _capture.grab();
+    if(_position >= _recording->framesAmount()) return false;
+
+    _position++;
+    return true;
+}
+
+bool FrameSource::read(cv::Mat& frame) noexcept
+{
+    if(!_recording) return _capture.read(frame);
+    if(!_recording->read(_position, _camera, _recordedFrame)) return false;
+
+    if(_recording->isZeroCopy())
+        _recordedFrame.copyTo(frame);
+    else
+        frame = _recordedFrame;
+
+    _position++;
+    return true;
+}
+
+double FrameSource::get(int property) noexcept
+{
+    if(!_recording) return _capture.get(property);
+
+    if(property == CV_CAP_PROP_FRAME_COUNT)
+        return _recording->framesAmount();
+    if(property == CV_CAP_PROP_POS_FRAMES)
+        return _position;
+    if(property == CV_CAP_PROP_POS_MSEC)
+        return _recording->timestamp(_position) / 1e6;
+    return 0;
+}
+
+bool FrameSource::set(int property, double value) noexcept
+{
+    if(!_recording) return _capture.set(property, value);
+    if(property != CV_CAP_PROP_POS_FRAMES ||
+       value < 0 || value > _recording->framesAmount())
+        return false;
+
+    _position = static_cast<int>(value);
+    return true;
+}
+
+bool FrameSource::isRecording(const std::string& source) noexcept
+{
+    size_t extension = source.rfind(RECORDING_EXTENSION);
+    if(extension == std::string::npos) return false;
+
+    size_t end = extension + RECORDING_EXTENSION.size();
+    return end == source.size() || source[end] == CAMERA_SEPARATOR;
+}
@@ -0,0 +1,41 @@
+#ifndef FRAMESOURCE_H
+#define FRAMESOURCE_H
+
+#include "FrameSetReader.h"
+
+#include <opencv2/highgui/highgui.hpp>
+
+#include <memory>
+#include <string>
+
+class FrameSource
+{
+public:
+    FrameSource() noexcept {}
+    FrameSource(const std::string& source) noexcept;
+
+    bool open(const std::string& source) noexcept;
+    bool isOpened() const noexcept;
+    void release() noexcept;
+
+    bool grab() noexcept;
+    bool read(cv::Mat& frame) noexcept;
+
+    double get(int property) noexcept;
+    bool set(int property, double value) noexcept;
+
+    static bool isRecording(const std::string& source) noexcept;
+
+    static const std::string RECORDING_EXTENSION;
+    static const char CAMERA_SEPARATOR = '#';
+
+private:
+    cv::VideoCapture _capture;
+
+    std::shared_ptr<FrameSetReader> _recording;
+    cv::Mat _recordedFrame;
+    int _camera   = 0;
+    int _position = 0;
+};
+
+#endif // FRAMESOURCE_H
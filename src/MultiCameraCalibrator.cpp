@@ -0,0 +1,327 @@
+#include "MultiCameraCalibrator.h"
+
+MultiCameraCalibrator::MultiCameraCalibrator(
+        const vector<std::string>& imagesPaths,
+        const ListOfPathsPairs& intrinsicsAndDistortions,
+        int boardWidth,
+        int boardHeight,
+        int referenceCamera)
+    throw (CamerasAmountError,
+           FramesAmountMatchError,
+           ReferenceCameraError,
+           MissingIntrinsicsError)
+    : _referenceCamera(referenceCamera),
+      _imagesPaths(imagesPaths),
+      _captures(imagesPaths.begin(), imagesPaths.end()),
+      _calibrationData(_captures.empty()
+                           ? 0 : _captures.front().get(CV_CAP_PROP_FRAME_COUNT),
+                       boardWidth,
+                       boardHeight),
+      _points(imagesPaths.size()),
+      _viewFrames(imagesPaths.size()),
+      _rotations(imagesPaths.size()),
+      _translations(imagesPaths.size())
+{
+    if(camerasAmount() < 2) throw CamerasAmountError();
+    for(auto& capture : _captures)
+        if(capture.get(CV_CAP_PROP_FRAME_COUNT) !=
+           _calibrationData.imagesAmount())
+            throw FramesAmountMatchError();
+    if(_referenceCamera < 0 || _referenceCamera >= camerasAmount())
+        throw ReferenceCameraError();
+
+    for(int camera = 0; camera < camerasAmount(); camera++)
+    {
+        _calibrationData.addIntrinsic(cv::Mat::eye(3, 3, CV_64F));
+        _calibrationData.addDistortion(cv::Mat::zeros(5, 1, CV_64F));
+    }
+    loadSingleCalibrationResults(intrinsicsAndDistortions);
+}
+
+bool MultiCameraCalibrator::execute() noexcept
+{
+    try{ findAllCorners(); }
+    catch(InterruptedByUser) { return false; }
+    if(!hasEnoughViews()) return false;
+
+    calibrateExtrinsics();
+    saveExtrinsics();
+    return true;
+}
+
+void MultiCameraCalibrator::useRectifyMapsCache(
+        const std::string& cacheDirectory) noexcept
+{
+    _rectifyMapGenerator.useCache(cacheDirectory);
+}
+
+void MultiCameraCalibrator::loadSingleCalibrationResults(
+        const ListOfPathsPairs& intrinsicsAndDistortions)
+    throw (MissingIntrinsicsError)
+{
+    if(static_cast<int>(intrinsicsAndDistortions.size()) != camerasAmount())
+        throw MissingIntrinsicsError();
+
+    for(int camera = 0; camera < camerasAmount(); camera++)
+    {
+        _calibrationData.loadIntrinsicMatrix(
+                intrinsicsAndDistortions[camera].first, camera);
+        _calibrationData.loadDistortionCoeffs(
+                intrinsicsAndDistortions[camera].second, camera);
+        if(_calibrationData.intrinsic(camera).size() != cv::Size(3, 3) ||
+           _calibrationData.distortion(camera).empty())
+            throw MissingIntrinsicsError();
+    }
+}
+
+bool MultiCameraCalibrator::readFrameSet(vector<cv::Mat>& frames) noexcept
+{
+    for(int camera = 0; camera < camerasAmount(); camera++)
+        if(!_captures[camera].read(frames[camera])) return false;
+    return true;
+}
+
+void MultiCameraCalibrator::findCornersOnFrameSet(
+        const vector<cv::Mat>& frames,
+        vector<cv::Mat>& grayImages,
+        vector<vector<cv::Point2f>>& corners,
+        vector<bool>& isFound) const noexcept
+{
+    vector<std::future<bool>> detections;
+
+    for(int camera = 0; camera < camerasAmount(); camera++)
+        detections.push_back(std::async(std::launch::async, [&, camera]()
+        {
+            return detectCorners(frames[camera],
+                                 _calibrationData.boardSize(),
+                                 grayImages[camera],
+                                 corners[camera]);
+        }));
+
+    for(int camera = 0; camera < camerasAmount(); camera++)
+        isFound[camera] = detections[camera].get();
+}
+
+void MultiCameraCalibrator::findAllCorners() throw (InterruptedByUser)
+{
+    vector<cv::Mat> frames(camerasAmount()), grayImages(camerasAmount());
+    vector<vector<cv::Point2f>> corners(camerasAmount());
+    vector<bool> isFound(camerasAmount());
+
+    for(auto& points : _points)
+        points.reserve(_calibrationData.imagesAmount(),
+                       _calibrationData.pointsOnBoardAmount());
+    for(int i = 0; i < _calibrationData.imagesAmount(); i++)
+    {
+        if(!readFrameSet(frames)) break;
+        _imageSize = frames[_referenceCamera].size();
+
+        findCornersOnFrameSet(frames, grayImages, corners, isFound);
+        for(int camera = 0; camera < camerasAmount(); camera++)
+            if(isFound[camera])
+            {
+                _points[camera].addView(corners[camera]);
+                _viewFrames[camera].push_back(i);
+            }
+        reportProgress(_points[_referenceCamera].viewsAmount(),
+                       _calibrationData.imagesAmount());
+        checkInterruptionCallback();
+    }
+    saveCornersCache();
+}
+
+void MultiCameraCalibrator::commonViews(int camera,
+                                        vector<cv::Mat>& referenceViews,
+                                        vector<cv::Mat>& cameraViews)
+    const noexcept
+{
+    const vector<int>& referenceFrames = _viewFrames[_referenceCamera];
+    const vector<int>& cameraFrames = _viewFrames[camera];
+    size_t referenceView = 0, cameraView = 0;
+
+    referenceViews.clear();
+    cameraViews.clear();
+    while(referenceView < referenceFrames.size() &&
+          cameraView < cameraFrames.size())
+    {
+        if(referenceFrames[referenceView] < cameraFrames[cameraView])
+            referenceView++;
+        else if(cameraFrames[cameraView] < referenceFrames[referenceView])
+            cameraView++;
+        else
+        {
+            referenceViews.push_back(
+                _points[_referenceCamera].view(referenceView++));
+            cameraViews.push_back(_points[camera].view(cameraView++));
+        }
+    }
+}
+
+bool MultiCameraCalibrator::hasEnoughViews() const noexcept
+{
+    vector<cv::Mat> referenceViews, cameraViews;
+    bool hasEnoughViews = true;
+
+    for(int camera = 0; camera < camerasAmount(); camera++)
+    {
+        if(camera == _referenceCamera) continue;
+
+        commonViews(camera, referenceViews, cameraViews);
+        if(static_cast<int>(cameraViews.size()) >= MIN_VIEWS_AMOUNT) continue;
+
+        std::cout << NOT_ENOUGH_VIEWS << camera << std::endl;
+        hasEnoughViews = false;
+    }
+    return hasEnoughViews;
+}
+
+void MultiCameraCalibrator::calibrateExtrinsics() noexcept
+{
+    std::cout << RUNNING_CALIBRATION << std::flush;
+
+    cv::Mat boardView(boardPoints(_calibrationData));
+    vector<std::future<double>> calibrations;
+    for(int camera = 0; camera < camerasAmount(); camera++)
+        if(camera != _referenceCamera)
+            calibrations.push_back(std::async(std::launch::async, [=]()
+            {
+                return calibrateCameraAgainstReference(camera, boardView);
+            }));
+
+    _rotations[_referenceCamera] = cv::Mat::eye(3, 3, CV_64F);
+    _translations[_referenceCamera] = cv::Mat::zeros(3, 1, CV_64F);
+
+    double error = 0;
+    for(auto& calibration : calibrations)
+        error = std::max(error, calibration.get());
+
+    std::cout << CALIBRATION_DONE << std::endl;
+    showCalibrationError(error);
+}
+
+double MultiCameraCalibrator::calibrateCameraAgainstReference(
+        int camera, const cv::Mat& boardView) noexcept
+{
+    vector<cv::Mat> referenceViews, cameraViews;
+    commonViews(camera, referenceViews, cameraViews);
+    vector<cv::Mat> objectViews(cameraViews.size(), boardView);
+
+    cv::Mat intrinsicReference =
+        _calibrationData.intrinsic(_referenceCamera).clone();
+    cv::Mat distortionReference =
+        _calibrationData.distortion(_referenceCamera).clone();
+    cv::Mat intrinsic = _calibrationData.intrinsic(camera).clone();
+    cv::Mat distortion = _calibrationData.distortion(camera).clone();
+    cv::Mat essentialMatrix, fundamentalMatrix;
+
+    return cv::stereoCalibrate(
+        objectViews, referenceViews, cameraViews,
+        intrinsicReference, distortionReference,
+        intrinsic, distortion,
+        _imageSize, _rotations[camera], _translations[camera],
+        essentialMatrix, fundamentalMatrix,
+        cv::TermCriteria(CV_TERMCRIT_ITER+CV_TERMCRIT_EPS, 100, 1e-5),
+        CV_CALIB_FIX_INTRINSIC);
+}
+
+StereoCalibrationData MultiCameraCalibrator::pairCalibrationData(
+        int firstCamera, int secondCamera) const noexcept
+{
+    StereoCalibrationData pairData(_calibrationData.imagesAmount(),
+                                   _calibrationData.boardWidth(),
+                                   _calibrationData.boardHeight());
+    cv::Mat rectTransform1, rectTransform2;
+    cv::Mat projectionMatrix1, projectionMatrix2, d2DMappingMatrix;
+    cv::Mat stereoRotation = _rotations[secondCamera] *
+                             _rotations[firstCamera].t();
+    cv::Mat stereoTranslation = _translations[secondCamera] -
+                                stereoRotation * _translations[firstCamera];
+
+    for(int camera : {firstCamera, secondCamera})
+    {
+        pairData.addIntrinsic(_calibrationData.intrinsic(camera));
+        pairData.addDistortion(_calibrationData.distortion(camera));
+    }
+
+    cv::stereoRectify(
+        pairData.intrinsic(0), pairData.distortion(0),
+        pairData.intrinsic(1), pairData.distortion(1),
+        _imageSize, stereoRotation, stereoTranslation,
+        rectTransform1, rectTransform2,
+        projectionMatrix1, projectionMatrix2,
+        d2DMappingMatrix, cv::CALIB_ZERO_DISPARITY);
+
+    pairData.setStereoRotation(stereoRotation);
+    pairData.setStereoTranslation(stereoTranslation);
+    pairData.setRectTransforms(rectTransform1, rectTransform2);
+    pairData.setProjectionMatrices(projectionMatrix1, projectionMatrix2);
+    pairData.setD2DMappingMatrix(d2DMappingMatrix);
+    return pairData;
+}
+
+void MultiCameraCalibrator::savePairRectification(int firstCamera,
+                                                  int secondCamera)
+    const noexcept
+{
+    StereoCalibrationData pairData = pairCalibrationData(firstCamera,
+                                                         secondCamera);
+    std::string suffix = pairSuffix(firstCamera, secondCamera);
+    cv::Mat rectifyMapX1, rectifyMapY1, rectifyMapX2, rectifyMapY2;
+
+    pairData.saveStereoRotationWithYmlExtension(
+                STEREO_ROTATION_OUTPUT_FILE + suffix);
+    pairData.saveStereoTranslationWithYmlExtension(
+                STEREO_TRANSLATION_OUTPUT_FILE + suffix);
+    pairData.saveRectTransformsWithYmlExtension(
+                RECT_TRANSFORMS_OUTPUT_FILE + suffix);
+    pairData.saveProjectionMatricesWithYmlExtension(
+                PROJECTION_MATRICES_OUTPUT_FILE + suffix);
+    pairData.saveD2DMappingMatrixWithYmlExtension(
+                D2D_MAPPING_MATRIX_OUTPUT_FILE + suffix);
+
+    _rectifyMapGenerator.generate(pairData.intrinsic(0),
+                                  pairData.distortion(0),
+                                  pairData.rectTransform1(),
+                                  pairData.projectionMatrix1(),
+                                  _imageSize, rectifyMapX1, rectifyMapY1);
+    _rectifyMapGenerator.generate(pairData.intrinsic(1),
+                                  pairData.distortion(1),
+                                  pairData.rectTransform2(),
+                                  pairData.projectionMatrix2(),
+                                  _imageSize, rectifyMapX2, rectifyMapY2);
+
+    cv::FileStorage fileStorage(RECTIFY_MAPS_OUTPUT_FILE + suffix,
+                                cv::FileStorage::WRITE);
+    fileStorage << RECTIFY_MAP_X1_TITLE << rectifyMapX1;
+    fileStorage << RECTIFY_MAP_Y1_TITLE << rectifyMapY1;
+    fileStorage << RECTIFY_MAP_X2_TITLE << rectifyMapX2;
+    fileStorage << RECTIFY_MAP_Y2_TITLE << rectifyMapY2;
+    fileStorage.release();
+}
+
+void MultiCameraCalibrator::saveExtrinsics() const noexcept
+{
+    cv::FileStorage fileStorage(EXTRINSICS_OUTPUT_FILE, cv::FileStorage::WRITE);
+    fileStorage << REFERENCE_CAMERA_TITLE << _referenceCamera;
+    for(int camera = 0; camera < camerasAmount(); camera++)
+    {
+        fileStorage << indexedTitle(ROTATION_TITLE, camera)
+                    << _rotations[camera];
+        fileStorage << indexedTitle(TRANSLATION_TITLE, camera)
+                    << _translations[camera];
+    }
+    fileStorage.release();
+}
+
+std::string MultiCameraCalibrator::pairSuffix(int firstCamera,
+                                              int secondCamera) const noexcept
+{
+    return "_" + std::to_string(firstCamera) +
+           "_" + std::to_string(secondCamera) + OUTPUT_FILES_EXTENSION;
+}
+
+std::string MultiCameraCalibrator::indexedTitle(const std::string& title,
+                                                int camera) const noexcept
+{
+    return title + " " + std::to_string(camera);
+}
@@ -0,0 +1,116 @@
+#ifndef MULTICAMERACALIBRATOR_H
+#define MULTICAMERACALIBRATOR_H
+
+#include "Calibrator.h"
+#include "StereoCalibrationData.h"
+#include "RectifyMapGenerator.h"
+#include "CommonExceptions.h"
+
+#include <opencv2/highgui/highgui.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+#include <opencv2/calib3d/calib3d.hpp>
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <utility>
+#include <future>
+
+using std::vector;
+using ListOfPathsPairs = vector<std::pair<std::string, std::string>>;
+
+class MultiCameraCalibrator : public Calibrator
+{
+public:
+    MultiCameraCalibrator(const vector<std::string>& imagesPaths,
+                          const ListOfPathsPairs& intrinsicsAndDistortions,
+                          int boardWidth,
+                          int boardHeight,
+                          int referenceCamera = 0)
+        throw (CamerasAmountError,
+               FramesAmountMatchError,
+               ReferenceCameraError,
+               MissingIntrinsicsError);
+
+    bool execute() noexcept;
+    void useRectifyMapsCache(const std::string& cacheDirectory) noexcept;
+
+    int camerasAmount() const noexcept { return _imagesPaths.size(); }
+    const cv::Mat& rotation(int camera) const noexcept
+    { return _rotations[camera]; }
+    const cv::Mat& translation(int camera) const noexcept
+    { return _translations[camera]; }
+
+    StereoCalibrationData pairCalibrationData(int firstCamera,
+                                              int secondCamera) const noexcept;
+    void savePairRectification(int firstCamera, int secondCamera)
+        const noexcept;
+
+private:
+    void loadSingleCalibrationResults(
+            const ListOfPathsPairs& intrinsicsAndDistortions)
+        throw (MissingIntrinsicsError);
+
+    bool readFrameSet(vector<cv::Mat>& frames) noexcept;
+    void findCornersOnFrameSet(const vector<cv::Mat>& frames,
+                               vector<cv::Mat>& grayImages,
+                               vector<vector<cv::Point2f>>& corners,
+                               vector<bool>& isFound) const noexcept;
+
+    void findAllCorners() throw (InterruptedByUser);
+
+    void commonViews(int camera,
+                     vector<cv::Mat>& referenceViews,
+                     vector<cv::Mat>& cameraViews) const noexcept;
+    bool hasEnoughViews() const noexcept;
+
+    void calibrateExtrinsics() noexcept;
+    double calibrateCameraAgainstReference(int camera,
+                                           const cv::Mat& boardView)
+        noexcept;
+
+    void saveExtrinsics() const noexcept;
+
+    std::string pairSuffix(int firstCamera, int secondCamera) const noexcept;
+    std::string indexedTitle(const std::string& title, int camera)
+        const noexcept;
+
+
+
+    int _referenceCamera;
+    vector<std::string> _imagesPaths;
+    vector<FrameSource> _captures;
+    CalibrationData _calibrationData;
+    RectifyMapGenerator _rectifyMapGenerator;
+
+    vector<CornerStore> _points;
+    vector<vector<int>> _viewFrames;
+    vector<cv::Mat> _rotations;
+    vector<cv::Mat> _translations;
+
+    cv::Size _imageSize;
+
+    const std::string EXTRINSICS_OUTPUT_FILE = "rig_extrinsics.yml";
+    const std::string STEREO_ROTATION_OUTPUT_FILE = "stereo_rotation";
+    const std::string STEREO_TRANSLATION_OUTPUT_FILE = "stereo_translation";
+    const std::string RECT_TRANSFORMS_OUTPUT_FILE = "rect_transforms";
+    const std::string PROJECTION_MATRICES_OUTPUT_FILE = "projection_matrices";
+    const std::string D2D_MAPPING_MATRIX_OUTPUT_FILE = "d2d_mapping_matrix";
+    const std::string RECTIFY_MAPS_OUTPUT_FILE = "rectify_maps";
+    const std::string OUTPUT_FILES_EXTENSION = ".yml";
+
+    const std::string ROTATION_TITLE    = "Rotation";
+    const std::string TRANSLATION_TITLE = "Translation";
+    const std::string REFERENCE_CAMERA_TITLE = "Reference Camera";
+    const std::string RECTIFY_MAP_X1_TITLE = "Rectify Map X1";
+    const std::string RECTIFY_MAP_Y1_TITLE = "Rectify Map Y1";
+    const std::string RECTIFY_MAP_X2_TITLE = "Rectify Map X2";
+    const std::string RECTIFY_MAP_Y2_TITLE = "Rectify Map Y2";
+
+    const std::string RUNNING_CALIBRATION = "Running rig calibration ...";
+    const std::string NOT_ENOUGH_VIEWS =
+        "Not enough views shared with the reference camera, camera: ";
+    const std::string CALIBRATION_DONE = " done";
+};
+
+#endif // MULTICAMERACALIBRATOR_H
@@ -19,6 +19,7 @@ void PhotoTaker::takePhotos(const int numberOfPhotos) noexcept
         showImagesForAllDevices();
     }
     closeWindowsForAllDevices();
+    if(_recorder) _recorder->close();
 }
 
 void PhotoTaker::setDevicesAndPaths(const ListOfStringsPairs &devicesAndPaths)
@@ -36,6 +37,15 @@ void PhotoTaker::setDevicesAndPaths(const ListOfStringsPairs &devicesAndPaths)
     }
 }
 
+void PhotoTaker::recordTo(const std::string& recordingPath,
+                          FrameEncoding encoding) noexcept
+{
+    if(_recorder) _recorder->close();
+    _recorder = nullptr;
+    _recordingPath = recordingPath;
+    _recordingEncoding = encoding;
+}
+
 void PhotoTaker::createWindowsForAllDevices() const noexcept
 {
     for(auto &tuple : _pathsCapturesAndImages)
@@ -74,6 +84,8 @@ MatSharedPtr PhotoTaker::nextImage(CaptureAndSource &captureAndSource)
 
 void PhotoTaker::nextImagesFromAllDevices() noexcept
 {
+    _imagesTimestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
     for(auto &tuple : _pathsCapturesAndImages)
     {
         std::get<2>(tuple) = nextImage(std::get<1>(tuple));
@@ -82,11 +94,11 @@ void PhotoTaker::nextImagesFromAllDevices() noexcept
 
 char PhotoTaker::waitForKeyInterruption() const noexcept
 {
-    return cv::waitKey(WAITING_TIME);
+    return DisplayManager::pollKey();
 }
 
 void PhotoTaker::handleKeyInterruption(char pressedKey, int &photosTaken)
-    const throw (InterruptedByUser)
+    throw (InterruptedByUser)
 {
     if(pressedKey == ESCAPE_KEY) throw InterruptedByUser();
     if(pressedKey == TAKE_KEY)
@@ -94,12 +106,17 @@ void PhotoTaker::handleKeyInterruption(char pressedKey, int &photosTaken)
         saveCurrentImages(photosTaken);
         photosTaken++;
         std::cout << SUCCESSFULLY_TAKEN << photosTaken << std::endl;
-        cv::waitKey(SAVED_IMAGE_SHOWING_TIME);
+        DisplayManager::waitKey(SAVED_IMAGE_SHOWING_TIME);
     }
 }
 
-void PhotoTaker::saveCurrentImages(int photoNumber) const noexcept
+void PhotoTaker::saveCurrentImages(int photoNumber) noexcept
 {
+    if(!_recordingPath.empty())
+    {
+        recordCurrentImages();
+        return;
+    }
     for(auto &tuple : _pathsCapturesAndImages)
     {
         std::string filePath = concatPath(std::get<0>(tuple), photoNumber);
@@ -107,6 +124,20 @@ void PhotoTaker::saveCurrentImages(int photoNumber) const noexcept
     }
 }
 
+void PhotoTaker::recordCurrentImages() noexcept
+{
+    if(!_recorder)
+        _recorder = std::make_shared<FrameSetRecorder>(
+                        _recordingPath, _pathsCapturesAndImages.size(),
+                        _recordingEncoding);
+
+    std::vector<cv::Mat> images;
+
+    for(auto &tuple : _pathsCapturesAndImages)
+        images.push_back(*std::get<2>(tuple));
+    _recorder->add(images, _imagesTimestamp);
+}
+
 std::string PhotoTaker::concatPath(std::string directoryPath, int photoNumber)
     const noexcept
 {
@@ -2,6 +2,7 @@
 #define PHOTOTAKER_H
 
 #include "CommonExceptions.h"
+#include "FrameSetRecorder.h"
 
 #include <opencv2/highgui/highgui.hpp>
 
@@ -11,6 +12,7 @@
 #include <memory>
 #include <iostream>
 #include <iomanip>
+#include <chrono>
 
 using MatSharedPtr = std::shared_ptr<cv::Mat>;
 using CaptureAndSource = std::pair<cv::VideoCapture, std::string>;
@@ -24,6 +26,8 @@ public:
 
     void takePhotos(const int numberOfPhotos) noexcept;
     void setDevicesAndPaths(const ListOfStringsPairs &devicesAndPaths) noexcept;
+    void recordTo(const std::string& recordingPath,
+                  FrameEncoding encoding = FrameEncoding::RAW) noexcept;
 
 private:
     void createWindowsForAllDevices() const noexcept;
@@ -36,9 +40,10 @@ private:
 
     char waitForKeyInterruption() const noexcept;
     void handleKeyInterruption(char pressedKey, int &photosTaken)
-        const throw (InterruptedByUser);
+        throw (InterruptedByUser);
 
-    void saveCurrentImages(int photoNumber) const noexcept;
+    void saveCurrentImages(int photoNumber) noexcept;
+    void recordCurrentImages() noexcept;
 
     std::string concatPath(std::string directoryPath, int photoNumber)
         const noexcept;
@@ -48,6 +53,10 @@ private:
     std::vector<std::tuple<std::string, CaptureAndSource, MatSharedPtr>>
         _pathsCapturesAndImages;
 
+    std::shared_ptr<FrameSetRecorder> _recorder;
+    std::string _recordingPath;
+    FrameEncoding _recordingEncoding = FrameEncoding::RAW;
+    int64_t _imagesTimestamp = 0;
 
     const char TAKE_KEY   = 't';
     const char ESCAPE_KEY = 27;
@@ -60,7 +69,6 @@ private:
     const std::string SUCCESSFULLY_TAKEN = "Successfully taken: ";
 
     const int SHOWING_TIME = 1;
-    const int WAITING_TIME = 15;
     const int SAVED_IMAGE_SHOWING_TIME = 1000;
 };
 
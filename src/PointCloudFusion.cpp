@@ -0,0 +1,392 @@
+#include "PointCloudFusion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <utility>
+
+class DepthIntegrator : public cv::ParallelLoopBody
+{
+public:
+    DepthIntegrator(const cv::Mat& points3D,
+                    const cv::Matx34f& pose,
+                    float voxelSize,
+                    int infinityValue,
+                    PointCloudFusion& fusion) noexcept
+        : _points3D(points3D),
+          _pose(pose),
+          _voxelSize(voxelSize),
+          _infinityValue(infinityValue),
+          _fusion(fusion)
+    {
+    }
+
+    void operator()(const cv::Range& range) const
+    {
+        vector<vector<VoxelSample>> samples(PointCloudFusion::SHARDS_AMOUNT);
+
+        for(int row = range.start; row < range.end; row++)
+        {
+            const cv::Point3f* points = _points3D.ptr<cv::Point3f>(row);
+            for(int col = 0; col < _points3D.cols; col++)
+                if(isValid(points[col]))
+                    addSample(transform(points[col]), samples);
+        }
+
+        for(int shard = 0; shard < PointCloudFusion::SHARDS_AMOUNT; shard++)
+            if(!samples[shard].empty())
+                _fusion.mergeSamples(samples[shard], shard);
+    }
+
+private:
+    bool isValid(const cv::Point3f& point) const
+    {
+        return std::abs(point.x) <= _infinityValue &&
+               std::abs(point.y) <= _infinityValue &&
+               std::abs(point.z) <= _infinityValue &&
+               point.z > 0;
+    }
+
+    cv::Point3f transform(const cv::Point3f& point) const
+    {
+        return cv::Point3f(
+            _pose(0, 0) * point.x + _pose(0, 1) * point.y +
+            _pose(0, 2) * point.z + _pose(0, 3),
+            _pose(1, 0) * point.x + _pose(1, 1) * point.y +
+            _pose(1, 2) * point.z + _pose(1, 3),
+            _pose(2, 0) * point.x + _pose(2, 1) * point.y +
+            _pose(2, 2) * point.z + _pose(2, 3));
+    }
+
+    void addSample(const cv::Point3f& point,
+                   vector<vector<VoxelSample>>& samples) const
+    {
+        int voxelX = cvFloor(point.x / _voxelSize);
+        int voxelY = cvFloor(point.y / _voxelSize);
+        int voxelZ = cvFloor(point.z / _voxelSize);
+        int blockX = floorDivide(voxelX), blockY = floorDivide(voxelY);
+        int blockZ = floorDivide(voxelZ);
+
+        VoxelSample sample;
+        sample.blockKey = PointCloudFusion::blockKey(blockX, blockY, blockZ);
+        sample.voxelIndex =
+            ((voxelZ - blockZ * VoxelBlock::SIDE) * VoxelBlock::SIDE +
+             (voxelY - blockY * VoxelBlock::SIDE)) * VoxelBlock::SIDE +
+             (voxelX - blockX * VoxelBlock::SIDE);
+        sample.point = point;
+
+        samples[PointCloudFusion::shardOf(sample.blockKey)].push_back(sample);
+    }
+
+    static int floorDivide(int voxel)
+    {
+        return voxel >= 0 ? voxel / VoxelBlock::SIDE
+                          : -((-voxel + VoxelBlock::SIDE - 1) / VoxelBlock::SIDE);
+    }
+
+    const cv::Mat& _points3D;
+    const cv::Matx34f _pose;
+    const float _voxelSize;
+    const int _infinityValue;
+    PointCloudFusion& _fusion;
+};
+
+PointCloudFusion::PointCloudFusion(const std::string& pathToD2DMappingMatrix,
+                                   const std::string& pathToPoses,
+                                   const std::string& spillPath) noexcept
+    : _spillPath(spillPath),
+      _spillOutput(spillPath, std::ofstream::binary | std::ofstream::trunc),
+      _shards(new VoxelBlockShard[SHARDS_AMOUNT])
+{
+    loadD2DMappingMatrix(pathToD2DMappingMatrix);
+    loadPoses(pathToPoses);
+}
+
+void PointCloudFusion::integrate(const cv::Mat& disparityMap, int frameIndex)
+    noexcept
+{
+    if(frameIndex < 0 || frameIndex >= static_cast<int>(_poses.size()))
+        return;
+    integrate(disparityMap, _poses[frameIndex]);
+}
+
+void PointCloudFusion::integrate(const cv::Mat& disparityMap,
+                                 const cv::Matx34f& pose) noexcept
+{
+    cv::reprojectImageTo3D(disparityMap, _points3D, _d2DMappingMatrix, true);
+
+    _integratedFrames++;
+    cv::parallel_for_(cv::Range(0, _points3D.rows),
+                      DepthIntegrator(_points3D, pose, _voxelSize,
+                                      INFINITY_VALUE, *this));
+
+    if(blocksAmount() > _maxBlocksAmount)
+        evictOldestBlocks();
+}
+
+void PointCloudFusion::integrateDisparityMapFile(
+        const std::string& pathToDisparityMap, int frameIndex) noexcept
+{
+    cv::Mat disparityMap;
+    cv::FileStorage fileStorage(pathToDisparityMap, cv::FileStorage::READ);
+    fileStorage[DISPARITY_MAP_TITLE] >> disparityMap;
+    fileStorage.release();
+
+    if(!disparityMap.empty())
+        integrate(disparityMap, frameIndex);
+}
+
+void PointCloudFusion::loadD2DMappingMatrix(
+        const std::string& pathToD2DMappingMatrix) noexcept
+{
+    cv::FileStorage fileStorage(pathToD2DMappingMatrix, cv::FileStorage::READ);
+    fileStorage[D2D_MAPPING_MATRIX_TITLE] >> _d2DMappingMatrix;
+    fileStorage.release();
+}
+
+void PointCloudFusion::loadPoses(const std::string& pathToPoses) noexcept
+{
+    std::ifstream input(pathToPoses);
+    std::string line;
+
+    _poses.clear();
+    while(std::getline(input, line))
+    {
+        std::istringstream values(line);
+        cv::Matx34f pose;
+        int valuesAmount = 0;
+
+        while(valuesAmount < 12 &&
+              values >> pose(valuesAmount / 4, valuesAmount % 4))
+            valuesAmount++;
+        if(valuesAmount == 12) _poses.push_back(pose);
+    }
+}
+
+void PointCloudFusion::savePointsWithPlyExtension() noexcept
+{
+    int pointsAmount = forEachSurfaceVoxel([](const FusedVoxel&) {});
+    std::ofstream outputFile(OUTPUT_FILENAME, std::ofstream::out);
+
+    outputFile << "ply" << std::endl;
+    outputFile << "format ascii 1.0" << std::endl;
+    outputFile << "element vertex " << pointsAmount << std::endl;
+    outputFile << "property float32 x" << std::endl;
+    outputFile << "property float32 y" << std::endl;
+    outputFile << "property float32 z" << std::endl;
+    outputFile << "end_header" << std::endl;
+    forEachSurfaceVoxel([&](const FusedVoxel& voxel)
+    {
+        writePoint(outputFile, voxel);
+    });
+    outputFile.close();
+    std::cout << "Fused point cloud saved to " << OUTPUT_FILENAME << std::endl;
+}
+
+void PointCloudFusion::setVoxelSize(float voxelSize) noexcept
+{
+    _voxelSize = voxelSize;
+}
+
+void PointCloudFusion::setMaxBlocksAmount(size_t maxBlocksAmount) noexcept
+{
+    _maxBlocksAmount = maxBlocksAmount;
+}
+
+void PointCloudFusion::setMinExportWeight(float minExportWeight) noexcept
+{
+    _minExportWeight = minExportWeight;
+}
+
+size_t PointCloudFusion::blocksAmount() const noexcept
+{
+    size_t amount = 0;
+
+    for(int shard = 0; shard < SHARDS_AMOUNT; shard++)
+    {
+        std::lock_guard<std::mutex> lock(_shards[shard].mutex);
+        amount += _shards[shard].blocks.size();
+    }
+    return amount;
+}
+
+size_t PointCloudFusion::posesAmount() const noexcept
+{
+    return _poses.size();
+}
+
+uint64_t PointCloudFusion::blockKey(int blockX, int blockY, int blockZ)
+    noexcept
+{
+    const uint64_t mask = (1 << 21) - 1;
+
+    return ((static_cast<uint64_t>(blockX) & mask) << 42) |
+           ((static_cast<uint64_t>(blockY) & mask) << 21) |
+            (static_cast<uint64_t>(blockZ) & mask);
+}
+
+int PointCloudFusion::shardOf(uint64_t blockKey) noexcept
+{
+    return ((blockKey * 0x9E3779B97F4A7C15ULL) >> 32) % SHARDS_AMOUNT;
+}
+
+void PointCloudFusion::mergeSamples(const vector<VoxelSample>& samples,
+                                    int shard) noexcept
+{
+    std::lock_guard<std::mutex> lock(_shards[shard].mutex);
+    auto& blocks = _shards[shard].blocks;
+
+    for(const auto& sample : samples)
+    {
+        auto& block = blocks[sample.blockKey];
+        if(!block)
+        {
+            block.reset(new VoxelBlock());
+            reloadSpilledBlock(_shards[shard], sample.blockKey, *block);
+        }
+        block->lastIntegratedFrame = _integratedFrames;
+
+        FusedVoxel observation;
+        observation.x = sample.point.x;
+        observation.y = sample.point.y;
+        observation.z = sample.point.z;
+        observation.weight = 1;
+        mergeVoxel(block->voxels[sample.voxelIndex], observation);
+    }
+}
+
+void PointCloudFusion::evictOldestBlocks() noexcept
+{
+    vector<std::pair<uint64_t, uint64_t>> ages;
+
+    for(int shard = 0; shard < SHARDS_AMOUNT; shard++)
+        for(const auto& block : _shards[shard].blocks)
+            ages.push_back(std::make_pair(block.second->lastIntegratedFrame,
+                                          block.first));
+
+    size_t evictedAmount =
+        ages.size() - static_cast<size_t>(_maxBlocksAmount * EVICTION_HEADROOM);
+    std::nth_element(ages.begin(), ages.begin() + evictedAmount, ages.end());
+
+    for(size_t i = 0; i < evictedAmount; i++)
+    {
+        VoxelBlockShard& shard = _shards[shardOf(ages[i].second)];
+        auto block = shard.blocks.find(ages[i].second);
+        spillBlock(shard, block->first, *block->second);
+        shard.blocks.erase(block);
+    }
+    _spillOutput.flush();
+}
+
+void PointCloudFusion::spillBlock(VoxelBlockShard& shard, uint64_t blockKey,
+                                  const VoxelBlock& block) noexcept
+{
+    uint32_t voxelsAmount = 0;
+
+    for(auto& voxel : block.voxels)
+        if(voxel.weight > 0) voxelsAmount++;
+
+    shard.spilledBlocks[blockKey] = _spillOutput.tellp();
+    _spillOutput.write(reinterpret_cast<const char*>(&voxelsAmount),
+                       sizeof(voxelsAmount));
+    for(int index = 0; index < VoxelBlock::VOXELS_AMOUNT; index++)
+    {
+        if(block.voxels[index].weight <= 0) continue;
+
+        SpilledVoxel spilled = {blockKey, index, block.voxels[index]};
+        _spillOutput.write(reinterpret_cast<const char*>(&spilled),
+                           sizeof(spilled));
+    }
+}
+
+void PointCloudFusion::reloadSpilledBlock(VoxelBlockShard& shard,
+                                          uint64_t blockKey,
+                                          VoxelBlock& block) const noexcept
+{
+    auto spilled = shard.spilledBlocks.find(blockKey);
+    if(spilled == shard.spilledBlocks.end()) return;
+
+    std::ifstream input(_spillPath, std::ifstream::binary);
+    readSpilledBlock(input, spilled->second, block);
+    shard.spilledBlocks.erase(spilled);
+}
+
+bool PointCloudFusion::readSpilledBlock(std::ifstream& input,
+                                        uint64_t offset,
+                                        VoxelBlock& block) const noexcept
+{
+    uint32_t voxelsAmount = 0;
+    SpilledVoxel spilled;
+
+    input.clear();
+    input.seekg(offset);
+    input.read(reinterpret_cast<char*>(&voxelsAmount), sizeof(voxelsAmount));
+    if(!input || voxelsAmount > VoxelBlock::VOXELS_AMOUNT) return false;
+
+    block.voxels.fill(FusedVoxel());
+    for(uint32_t i = 0; i < voxelsAmount; i++)
+    {
+        if(!input.read(reinterpret_cast<char*>(&spilled), sizeof(spilled)) ||
+           spilled.voxelIndex < 0 ||
+           spilled.voxelIndex >= VoxelBlock::VOXELS_AMOUNT)
+            return false;
+        block.voxels[spilled.voxelIndex] = spilled.voxel;
+    }
+    return true;
+}
+
+void PointCloudFusion::mergeVoxel(FusedVoxel& voxel, const FusedVoxel& other)
+    const noexcept
+{
+    float weight = voxel.weight + other.weight;
+    if(weight <= 0) return;
+
+    voxel.x += (other.x - voxel.x) * other.weight / weight;
+    voxel.y += (other.y - voxel.y) * other.weight / weight;
+    voxel.z += (other.z - voxel.z) * other.weight / weight;
+    voxel.weight = std::min(weight, MAX_VOXEL_WEIGHT);
+}
+
+int PointCloudFusion::forEachSurfaceVoxel(
+        const std::function<void(const FusedVoxel&)>& visit) const noexcept
+{
+    std::ifstream spillInput(_spillPath, std::ifstream::binary);
+    VoxelBlock spilledBlock;
+    int pointsAmount = 0;
+
+    for(int shard = 0; shard < SHARDS_AMOUNT; shard++)
+    {
+        std::lock_guard<std::mutex> lock(_shards[shard].mutex);
+        for(const auto& block : _shards[shard].blocks)
+            for(const auto& voxel : block.second->voxels)
+            {
+                if(!isSurfaceVoxel(voxel)) continue;
+                visit(voxel);
+                pointsAmount++;
+            }
+
+        for(const auto& spilled : _shards[shard].spilledBlocks)
+        {
+            if(!readSpilledBlock(spillInput, spilled.second, spilledBlock))
+                continue;
+            for(const auto& voxel : spilledBlock.voxels)
+            {
+                if(!isSurfaceVoxel(voxel)) continue;
+                visit(voxel);
+                pointsAmount++;
+            }
+        }
+    }
+    return pointsAmount;
+}
+
+void PointCloudFusion::writePoint(std::ostream& output,
+                                  const FusedVoxel& voxel) const noexcept
+{
+    output << voxel.x << " " << voxel.y << " " << voxel.z << std::endl;
+}
+
+bool PointCloudFusion::isSurfaceVoxel(const FusedVoxel& voxel) const noexcept
+{
+    return voxel.weight >= _minExportWeight;
+}
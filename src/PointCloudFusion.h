@@ -0,0 +1,136 @@
+#ifndef POINTCLOUDFUSION_H
+#define POINTCLOUDFUSION_H
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/calib3d/calib3d.hpp>
+
+#include <string>
+#include <vector>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+#include <iostream>
+#include <fstream>
+#include <functional>
+
+using std::vector;
+
+struct FusedVoxel
+{
+    float x      = 0;
+    float y      = 0;
+    float z      = 0;
+    float weight = 0;
+};
+
+struct VoxelBlock
+{
+    static const int SIDE = 8;
+    static const int VOXELS_AMOUNT = SIDE * SIDE * SIDE;
+
+    std::array<FusedVoxel, VOXELS_AMOUNT> voxels;
+    uint64_t lastIntegratedFrame = 0;
+};
+
+struct VoxelBlockShard
+{
+    std::mutex mutex;
+    std::unordered_map<uint64_t, std::unique_ptr<VoxelBlock>> blocks;
+    std::unordered_map<uint64_t, uint64_t> spilledBlocks;
+};
+
+struct SpilledVoxel
+{
+    uint64_t blockKey;
+    int voxelIndex;
+    FusedVoxel voxel;
+};
+
+struct VoxelSample
+{
+    uint64_t blockKey;
+    int voxelIndex;
+    cv::Point3f point;
+};
+
+class PointCloudFusion
+{
+public:
+    PointCloudFusion(const std::string& pathToD2DMappingMatrix,
+                     const std::string& pathToPoses,
+                     const std::string& spillPath) noexcept;
+
+    void integrate(const cv::Mat& disparityMap, int frameIndex) noexcept;
+    void integrate(const cv::Mat& disparityMap, const cv::Matx34f& pose)
+        noexcept;
+    void integrateDisparityMapFile(const std::string& pathToDisparityMap,
+                                   int frameIndex) noexcept;
+
+    void loadD2DMappingMatrix(const std::string& pathToD2DMappingMatrix)
+        noexcept;
+    void loadPoses(const std::string& pathToPoses) noexcept;
+
+    void savePointsWithPlyExtension() noexcept;
+
+    void setVoxelSize(float voxelSize) noexcept;
+    void setMaxBlocksAmount(size_t maxBlocksAmount) noexcept;
+    void setMinExportWeight(float minExportWeight) noexcept;
+
+    size_t blocksAmount() const noexcept;
+    size_t posesAmount() const noexcept;
+
+    static const int SHARDS_AMOUNT = 64;
+
+    static uint64_t blockKey(int blockX, int blockY, int blockZ) noexcept;
+    static int shardOf(uint64_t blockKey) noexcept;
+
+private:
+    friend class DepthIntegrator;
+
+    void mergeSamples(const vector<VoxelSample>& samples, int shard) noexcept;
+    void evictOldestBlocks() noexcept;
+    void spillBlock(VoxelBlockShard& shard, uint64_t blockKey,
+                    const VoxelBlock& block) noexcept;
+    void reloadSpilledBlock(VoxelBlockShard& shard, uint64_t blockKey,
+                            VoxelBlock& block) const noexcept;
+    bool readSpilledBlock(std::ifstream& input, uint64_t offset,
+                          VoxelBlock& block) const noexcept;
+    void mergeVoxel(FusedVoxel& voxel, const FusedVoxel& other)
+        const noexcept;
+    int forEachSurfaceVoxel(
+            const std::function<void(const FusedVoxel&)>& visit)
+        const noexcept;
+    void writePoint(std::ostream& output, const FusedVoxel& voxel)
+        const noexcept;
+    bool isSurfaceVoxel(const FusedVoxel& voxel) const noexcept;
+
+
+
+    std::string _spillPath;
+    std::ofstream _spillOutput;
+
+    cv::Mat _d2DMappingMatrix;
+    cv::Mat _points3D;
+    vector<cv::Matx34f> _poses;
+
+    std::unique_ptr<VoxelBlockShard[]> _shards;
+    uint64_t _integratedFrames = 0;
+
+    float _voxelSize = 0.01f;
+    size_t _maxBlocksAmount = 1 << 16;
+    float _minExportWeight = 2;
+
+    const int INFINITY_VALUE = 500;
+    const float MAX_VOXEL_WEIGHT = 255;
+    const float EVICTION_HEADROOM = 0.9f;
+
+    const std::string OUTPUT_FILENAME = "fused_points.ply";
+
+    const std::string DISPARITY_MAP_TITLE = "Disparity Map";
+    const std::string D2D_MAPPING_MATRIX_TITLE =
+        "Disparity-to-depth Mapping Matrix";
+};
+
+#endif // POINTCLOUDFUSION_H
@@ -1,5 +1,65 @@
 #include "PointCloudGenerator.h"
 
+class ConfidentPointsReprojector : public cv::ParallelLoopBody
+{
+public:
+    ConfidentPointsReprojector(const cv::Mat& disparityMap,
+                               const cv::Mat& confidenceMap,
+                               const cv::Mat& d2DMappingMatrix,
+                               int confidenceThreshold,
+                               float missingDepth,
+                               cv::Mat& depthMap) noexcept
+        : _disparityMap(disparityMap),
+          _confidenceMap(confidenceMap),
+          _confidenceThreshold(confidenceThreshold),
+          _missingDepth(missingDepth),
+          _depthMap(depthMap)
+    {
+        d2DMappingMatrix.convertTo(_q, CV_64F);
+    }
+
+    void operator()(const cv::Range& rows) const
+    {
+        const double* q = _q.ptr<double>();
+
+        for(int y = rows.start; y < rows.end; y++)
+        {
+            const float* disparity = _disparityMap.ptr<float>(y);
+            const uint8_t* confidence = _confidenceMap.ptr<uint8_t>(y);
+            cv::Point3f* points = _depthMap.ptr<cv::Point3f>(y);
+
+            for(int x = 0; x < _disparityMap.cols; x++)
+            {
+                if(confidence[x] < _confidenceThreshold)
+                {
+                    points[x] = cv::Point3f(0, 0, _missingDepth);
+                    continue;
+                }
+
+                double d = disparity[x];
+                double X = q[0] * x + q[1] * y + q[2] * d + q[3];
+                double Y = q[4] * x + q[5] * y + q[6] * d + q[7];
+                double Z = q[8] * x + q[9] * y + q[10] * d + q[11];
+                double W = q[12] * x + q[13] * y + q[14] * d + q[15];
+                if(W == 0)
+                {
+                    points[x] = cv::Point3f(0, 0, _missingDepth);
+                    continue;
+                }
+                points[x] = cv::Point3f(X / W, Y / W, Z / W);
+            }
+        }
+    }
+
+private:
+    const cv::Mat& _disparityMap;
+    const cv::Mat& _confidenceMap;
+    cv::Mat _q;
+    const int _confidenceThreshold;
+    const float _missingDepth;
+    cv::Mat& _depthMap;
+};
+
 PointCloudGenerator::PointCloudGenerator(
         const std::string& pathToDisparityMap,
         const std::string& pathToD2DMappingMatrix) noexcept
@@ -8,12 +68,65 @@ PointCloudGenerator::PointCloudGenerator(
     loadD2DMappingMatrix(pathToD2DMappingMatrix);
 }
 
+PointCloudGenerator::PointCloudGenerator(const cv::Mat& disparityMap,
+                                         const cv::Mat& d2DMappingMatrix)
+    noexcept
+    : _disparityMap(disparityMap),
+      _d2DMappingMatrix(d2DMappingMatrix)
+{
+}
+
 void PointCloudGenerator::generate() noexcept
 {
-    cv::reprojectImageTo3D(_disparityMap, _depthMap, _d2DMappingMatrix);
+    computePoints();
     savePointsWithPlyExtension();
 }
 
+const cv::Mat& PointCloudGenerator::computePoints() noexcept
+{
+    if(_confidenceMap.empty() || _confidenceThreshold <= 0 ||
+       _confidenceMap.size() != _disparityMap.size())
+        cv::reprojectImageTo3D(_disparityMap, _depthMap, _d2DMappingMatrix);
+    else
+        reprojectConfidentPoints();
+    return _depthMap;
+}
+
+void PointCloudGenerator::reprojectConfidentPoints() noexcept
+{
+    if(_disparityMap.type() == CV_32F)
+        _floatDisparityMap = _disparityMap;
+    else
+        _disparityMap.convertTo(_floatDisparityMap, CV_32F);
+    _depthMap.create(_disparityMap.size(), CV_32FC3);
+    cv::parallel_for_(cv::Range(0, _disparityMap.rows),
+                      ConfidentPointsReprojector(_floatDisparityMap,
+                                                 _confidenceMap,
+                                                 _d2DMappingMatrix,
+                                                 _confidenceThreshold,
+                                                 MISSING_DEPTH,
+                                                 _depthMap));
+}
+
+void PointCloudGenerator::setDisparityMap(const cv::Mat& disparityMap)
+    noexcept
+{
+    _disparityMap = disparityMap;
+}
+
+void PointCloudGenerator::setD2DMappingMatrix(const cv::Mat& d2DMappingMatrix)
+    noexcept
+{
+    _d2DMappingMatrix = d2DMappingMatrix;
+}
+
+void PointCloudGenerator::setConfidenceMap(const cv::Mat& confidenceMap,
+                                           int confidenceThreshold) noexcept
+{
+    _confidenceMap = confidenceMap;
+    _confidenceThreshold = confidenceThreshold;
+}
+
 void PointCloudGenerator::loadDisparityMap(const std::string &pathToDisparityMap)
         noexcept
 {
@@ -54,6 +167,7 @@ void PointCloudGenerator::addPlyHeader(int pointsAmount) noexcept
 int PointCloudGenerator::computeOutput() noexcept
 {
     int pointsAmount = 0;
+    _output.str(std::string());
     for (int x = 0; x < _depthMap.rows; x++) {
         for (int y = 0; y < _depthMap.cols; y++) {
             cv::Point3f point = _depthMap.at<cv::Point3f>(x, y);
@@ -13,15 +13,23 @@ class PointCloudGenerator
 public:
     PointCloudGenerator(const std::string& pathToDisparityMap,
                         const std::string& pathToD2DMappingMatrix) noexcept;
+    PointCloudGenerator(const cv::Mat& disparityMap,
+                        const cv::Mat& d2DMappingMatrix) noexcept;
 
     void generate() noexcept;
+    const cv::Mat& computePoints() noexcept;
+    void savePointsWithPlyExtension() noexcept;
 
     void loadDisparityMap(const std::string& pathToDisparityMap) noexcept;
     void loadD2DMappingMatrix(const std::string& pathToD2DMappingMatrix) noexcept;
+    void setDisparityMap(const cv::Mat& disparityMap) noexcept;
+    void setD2DMappingMatrix(const cv::Mat& d2DMappingMatrix) noexcept;
+    void setConfidenceMap(const cv::Mat& confidenceMap,
+                          int confidenceThreshold) noexcept;
 
 private:
-    void savePointsWithPlyExtension() noexcept;
 
+    void reprojectConfidentPoints() noexcept;
     void addPlyHeader(int pointsAmount) noexcept;
     int computeOutput() noexcept;
 
@@ -30,11 +38,15 @@ private:
     cv::Mat _disparityMap;
     cv::Mat _d2DMappingMatrix;
     cv::Mat _depthMap;
+    cv::Mat _confidenceMap;
+    cv::Mat _floatDisparityMap;
+    int _confidenceThreshold = 0;
 
     std::stringstream _output;
     std::ofstream _outputFile;
 
     const int INFINITY_VALUE = 500;
+    const float MISSING_DEPTH = 10000;
 
     const std::string OUTPUT_FILENAME = "points.ply";
 
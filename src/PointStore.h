@@ -0,0 +1,94 @@
+#ifndef POINTSTORE_H
+#define POINTSTORE_H
+
+#include <opencv2/core/core.hpp>
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+template<typename Point>
+class PointStore
+{
+public:
+    PointStore() noexcept : _offsets(1, 0) {}
+
+    void reserve(size_t viewsAmount, size_t pointsPerView) noexcept
+    {
+        _points.reserve(viewsAmount * pointsPerView);
+        _offsets.reserve(viewsAmount + 1);
+    }
+
+    void addView(const std::vector<Point>& points) noexcept
+    {
+        _points.insert(_points.end(), points.begin(), points.end());
+        _offsets.push_back(_points.size());
+    }
+
+    void keepViews(const std::vector<int>& views) noexcept
+    {
+        size_t pointsAmount = 0;
+
+        for(size_t kept = 0; kept < views.size(); kept++)
+        {
+            size_t first = _offsets[views[kept]];
+            size_t last  = _offsets[views[kept] + 1];
+
+            std::copy(_points.begin() + first,
+                      _points.begin() + last,
+                      _points.begin() + pointsAmount);
+            pointsAmount += last - first;
+            _offsets[kept + 1] = pointsAmount;
+        }
+        _points.resize(pointsAmount);
+        _offsets.resize(views.size() + 1);
+    }
+
+    void clear() noexcept
+    {
+        _points.clear();
+        _offsets.assign(1, 0);
+    }
+
+    size_t viewsAmount() const noexcept { return _offsets.size() - 1; }
+    size_t pointsAmount() const noexcept { return _points.size(); }
+    size_t viewSize(size_t view) const noexcept
+    { return _offsets[view + 1] - _offsets[view]; }
+
+    Point* points(size_t view) noexcept
+    { return _points.data() + _offsets[view]; }
+    const Point* points(size_t view) const noexcept
+    { return _points.data() + _offsets[view]; }
+
+    cv::Mat view(size_t view) const noexcept
+    { return header(points(view), viewSize(view)); }
+
+    std::vector<cv::Mat> views() const noexcept
+    {
+        std::vector<cv::Mat> headers(viewsAmount());
+
+        for(size_t view = 0; view < headers.size(); view++)
+            headers[view] = this->view(view);
+        return headers;
+    }
+
+    cv::Mat allPoints() const noexcept
+    { return header(_points.data(), _points.size()); }
+
+private:
+    static cv::Mat header(const Point* data, size_t amount) noexcept
+    {
+        return cv::Mat(amount, 1, cv::DataType<Point>::type,
+                       const_cast<Point*>(data));
+    }
+
+
+
+    std::vector<Point> _points;
+    std::vector<size_t> _offsets;
+};
+
+using CornerStore = PointStore<cv::Point2f>;
+using ObjectPointStore = PointStore<cv::Point3f>;
+
+#endif // POINTSTORE_H
@@ -0,0 +1,205 @@
+#include "RectifyMapGenerator.h"
+#include "ContentHash.h"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+#include <sys/stat.h>
+
+const std::string RectifyMapGenerator::CACHE_FILE_EXTENSION = ".map";
+const std::string RectifyMapGenerator::PARTIAL_CACHE_FILE_EXTENSION = ".part";
+
+class RectifyMapBandGenerator : public cv::ParallelLoopBody
+{
+public:
+    RectifyMapBandGenerator(const cv::Mat& intrinsic,
+                            const cv::Mat& distortion,
+                            const cv::Mat& rectTransform,
+                            const cv::Mat& newCameraMatrix,
+                            cv::Mat& rectifyMapX,
+                            cv::Mat& rectifyMapY,
+                            int bandHeight) noexcept
+        : _intrinsic(intrinsic),
+          _distortion(distortion),
+          _rectTransform(rectTransform),
+          _rectifyMapX(rectifyMapX),
+          _rectifyMapY(rectifyMapY),
+          _bandHeight(bandHeight)
+    {
+        newCameraMatrix.colRange(0, 3).convertTo(_newCameraMatrix, CV_64F);
+    }
+
+    void operator()(const cv::Range& bands) const
+    {
+        for(int band = bands.start; band < bands.end; band++)
+        {
+            int firstRow = band * _bandHeight;
+            int lastRow  = std::min(firstRow + _bandHeight, _rectifyMapX.rows);
+            cv::Mat bandMapX = _rectifyMapX.rowRange(firstRow, lastRow);
+            cv::Mat bandMapY = _rectifyMapY.rowRange(firstRow, lastRow);
+
+            cv::initUndistortRectifyMap(_intrinsic,
+                                        _distortion,
+                                        _rectTransform,
+                                        shiftedCameraMatrix(firstRow),
+                                        bandMapX.size(),
+                                        CV_32F,
+                                        bandMapX,
+                                        bandMapY);
+        }
+    }
+
+private:
+    cv::Mat shiftedCameraMatrix(int firstRow) const noexcept
+    {
+        cv::Mat cameraMatrix = _newCameraMatrix.clone();
+        for(int column = 0; column < 3; column++)
+            cameraMatrix.at<double>(1, column) -=
+                firstRow * cameraMatrix.at<double>(2, column);
+        return cameraMatrix;
+    }
+
+    const cv::Mat& _intrinsic;
+    const cv::Mat& _distortion;
+    const cv::Mat& _rectTransform;
+    cv::Mat _newCameraMatrix;
+    cv::Mat& _rectifyMapX;
+    cv::Mat& _rectifyMapY;
+    int _bandHeight;
+};
+
+RectifyMapGenerator::RectifyMapGenerator(const std::string& cacheDirectory)
+    noexcept
+    : _cacheDirectory(cacheDirectory)
+{
+}
+
+void RectifyMapGenerator::generate(const cv::Mat& intrinsic,
+                                   const cv::Mat& distortion,
+                                   const cv::Mat& rectTransform,
+                                   const cv::Mat& newCameraMatrix,
+                                   const cv::Size& size,
+                                   cv::Mat& rectifyMapX,
+                                   cv::Mat& rectifyMapY) const noexcept
+{
+    uint64_t mapsKey = key(intrinsic, distortion, rectTransform,
+                           newCameraMatrix, size);
+
+    if(loadFromCache(mapsKey, size, rectifyMapX, rectifyMapY)) return;
+
+    generateInParallel(intrinsic, distortion, rectTransform, newCameraMatrix,
+                       size, rectifyMapX, rectifyMapY);
+    saveToCache(mapsKey, rectifyMapX, rectifyMapY);
+}
+
+void RectifyMapGenerator::useCache(const std::string& cacheDirectory)
+    noexcept
+{
+    _cacheDirectory = cacheDirectory;
+}
+
+uint64_t RectifyMapGenerator::key(const cv::Mat& intrinsic,
+                                  const cv::Mat& distortion,
+                                  const cv::Mat& rectTransform,
+                                  const cv::Mat& newCameraMatrix,
+                                  const cv::Size& size) noexcept
+{
+    return ContentHash().add(intrinsic)
+                        .add(distortion)
+                        .add(rectTransform)
+                        .add(newCameraMatrix)
+                        .add(size.width)
+                        .add(size.height)
+                        .value();
+}
+
+void RectifyMapGenerator::generateInParallel(const cv::Mat& intrinsic,
+                                             const cv::Mat& distortion,
+                                             const cv::Mat& rectTransform,
+                                             const cv::Mat& newCameraMatrix,
+                                             const cv::Size& size,
+                                             cv::Mat& rectifyMapX,
+                                             cv::Mat& rectifyMapY)
+    const noexcept
+{
+    int bandsAmount = (size.height + BAND_HEIGHT - 1) / BAND_HEIGHT;
+
+    rectifyMapX.create(size, CV_32F);
+    rectifyMapY.create(size, CV_32F);
+    cv::parallel_for_(cv::Range(0, bandsAmount),
+                      RectifyMapBandGenerator(intrinsic,
+                                              distortion,
+                                              rectTransform,
+                                              newCameraMatrix,
+                                              rectifyMapX,
+                                              rectifyMapY,
+                                              BAND_HEIGHT));
+}
+
+std::string RectifyMapGenerator::cachePath(uint64_t key) const noexcept
+{
+    std::stringstream stringStream;
+    stringStream << _cacheDirectory << '/';
+    stringStream << std::hex << std::setw(16) << std::setfill('0') << key;
+    stringStream << CACHE_FILE_EXTENSION;
+    return stringStream.str();
+}
+
+bool RectifyMapGenerator::loadFromCache(uint64_t key,
+                                        const cv::Size& size,
+                                        cv::Mat& rectifyMapX,
+                                        cv::Mat& rectifyMapY) const noexcept
+{
+    if(_cacheDirectory.empty()) return false;
+
+    std::ifstream input(cachePath(key), std::ifstream::binary);
+    uint32_t magic = 0;
+    int32_t rows = 0, cols = 0;
+
+    input.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    input.read(reinterpret_cast<char*>(&rows), sizeof(rows));
+    input.read(reinterpret_cast<char*>(&cols), sizeof(cols));
+    if(!input || magic != CACHE_FILE_MAGIC ||
+       rows != size.height || cols != size.width)
+        return false;
+
+    rectifyMapX.create(size, CV_32F);
+    rectifyMapY.create(size, CV_32F);
+    for(int row = 0; row < rows; row++)
+        input.read(reinterpret_cast<char*>(rectifyMapX.ptr<float>(row)),
+                   cols * sizeof(float));
+    for(int row = 0; row < rows; row++)
+        input.read(reinterpret_cast<char*>(rectifyMapY.ptr<float>(row)),
+                   cols * sizeof(float));
+    return static_cast<bool>(input);
+}
+
+void RectifyMapGenerator::saveToCache(uint64_t key,
+                                      const cv::Mat& rectifyMapX,
+                                      const cv::Mat& rectifyMapY) const noexcept
+{
+    if(_cacheDirectory.empty()) return;
+    mkdir(_cacheDirectory.c_str(), 0755);
+
+    std::string path = cachePath(key);
+    std::string partialPath = path + PARTIAL_CACHE_FILE_EXTENSION;
+    std::ofstream output(partialPath,
+                         std::ofstream::binary | std::ofstream::trunc);
+    uint32_t magic = CACHE_FILE_MAGIC;
+    int32_t rows = rectifyMapX.rows, cols = rectifyMapX.cols;
+
+    output.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+    output.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+    output.write(reinterpret_cast<const char*>(&cols), sizeof(cols));
+    for(int row = 0; row < rows; row++)
+        output.write(reinterpret_cast<const char*>(rectifyMapX.ptr<float>(row)),
+                     cols * sizeof(float));
+    for(int row = 0; row < rows; row++)
+        output.write(reinterpret_cast<const char*>(rectifyMapY.ptr<float>(row)),
+                     cols * sizeof(float));
+    output.close();
+
+    if(!output || std::rename(partialPath.c_str(), path.c_str()) != 0)
+        std::remove(partialPath.c_str());
+}
@@ -0,0 +1,79 @@
+#ifndef RECTIFYMAPGENERATOR_H
+#define RECTIFYMAPGENERATOR_H
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <cstdint>
+#include <string>
+
+struct RectifyMaps
+{
+    cv::Mat leftX;
+    cv::Mat leftY;
+    cv::Mat rightX;
+    cv::Mat rightY;
+};
+
+struct RectificationProfile
+{
+    std::string name;
+    double scale = 1;
+    cv::Size imageSize;
+    cv::Mat projectionMatrix1;
+    cv::Mat projectionMatrix2;
+    cv::Mat d2DMappingMatrix;
+    RectifyMaps maps;
+};
+
+class RectifyMapGenerator
+{
+public:
+    RectifyMapGenerator() noexcept {}
+    RectifyMapGenerator(const std::string& cacheDirectory) noexcept;
+
+    void generate(const cv::Mat& intrinsic,
+                  const cv::Mat& distortion,
+                  const cv::Mat& rectTransform,
+                  const cv::Mat& newCameraMatrix,
+                  const cv::Size& size,
+                  cv::Mat& rectifyMapX,
+                  cv::Mat& rectifyMapY) const noexcept;
+
+    void useCache(const std::string& cacheDirectory) noexcept;
+
+    static uint64_t key(const cv::Mat& intrinsic,
+                        const cv::Mat& distortion,
+                        const cv::Mat& rectTransform,
+                        const cv::Mat& newCameraMatrix,
+                        const cv::Size& size) noexcept;
+
+private:
+    void generateInParallel(const cv::Mat& intrinsic,
+                            const cv::Mat& distortion,
+                            const cv::Mat& rectTransform,
+                            const cv::Mat& newCameraMatrix,
+                            const cv::Size& size,
+                            cv::Mat& rectifyMapX,
+                            cv::Mat& rectifyMapY) const noexcept;
+
+    std::string cachePath(uint64_t key) const noexcept;
+    bool loadFromCache(uint64_t key,
+                       const cv::Size& size,
+                       cv::Mat& rectifyMapX,
+                       cv::Mat& rectifyMapY) const noexcept;
+    void saveToCache(uint64_t key,
+                     const cv::Mat& rectifyMapX,
+                     const cv::Mat& rectifyMapY) const noexcept;
+
+
+
+    std::string _cacheDirectory;
+
+    static const std::string CACHE_FILE_EXTENSION;
+    static const std::string PARTIAL_CACHE_FILE_EXTENSION;
+    static const uint32_t CACHE_FILE_MAGIC = 0x3150414d;
+    static const int BAND_HEIGHT = 64;
+};
+
+#endif // RECTIFYMAPGENERATOR_H
@@ -0,0 +1,23 @@
+#include "SGBMBackend.h"
+
+void SGBMBackend::compute(const cv::Mat& leftImage,
+                          const cv::Mat& rightImage,
+                          cv::Mat& disparity) noexcept
+{
+    applyParameters();
+    _stereoSGBMState(leftImage, rightImage, disparity);
+}
+
+void SGBMBackend::applyParameters() noexcept
+{
+    _stereoSGBMState.minDisparity        = _parameters.minDisparity;
+    _stereoSGBMState.numberOfDisparities = _parameters.numberOfDisparities;
+    _stereoSGBMState.SADWindowSize       = _parameters.blockSize;
+    _stereoSGBMState.disp12MaxDiff       = _parameters.disp12MaxDiff;
+    _stereoSGBMState.preFilterCap        = _parameters.preFilterCap;
+    _stereoSGBMState.uniquenessRatio     = _parameters.uniquenessRatio;
+    _stereoSGBMState.speckleWindowSize   = _parameters.speckleWindowSize;
+    _stereoSGBMState.speckleRange        = _parameters.speckleRange;
+    _stereoSGBMState.P1                  = _parameters.smoothnessPar1;
+    _stereoSGBMState.P2                  = _parameters.smoothnessPar2;
+}
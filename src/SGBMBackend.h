@@ -0,0 +1,29 @@
+#ifndef SGBMBACKEND_H
+#define SGBMBACKEND_H
+
+#include "StereoMatcherBackend.h"
+
+#include <opencv2/calib3d/calib3d.hpp>
+
+class SGBMBackend : public StereoMatcherBackend
+{
+public:
+    SGBMBackend() noexcept {}
+
+    void compute(const cv::Mat& leftImage,
+                 const cv::Mat& rightImage,
+                 cv::Mat& disparity) noexcept;
+
+    std::string name() const noexcept { return NAME; }
+
+private:
+    void applyParameters() noexcept;
+
+
+
+    cv::StereoSGBM _stereoSGBMState;
+
+    const std::string NAME = "SGBM";
+};
+
+#endif // SGBMBACKEND_H
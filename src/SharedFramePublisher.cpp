@@ -0,0 +1,148 @@
+#include "SharedFramePublisher.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SharedFramePublisher::SharedFramePublisher(const std::string& name,
+                                           size_t slotCapacity,
+                                           int slotsAmount) noexcept
+    : _name(name),
+      _slotsAmount(static_cast<uint32_t>(std::max(slotsAmount, 2))),
+      _slotCapacity(static_cast<uint32_t>(slotCapacity))
+{
+    _mappingSize = SharedFrameRing::mappingSize(_slotsAmount, _slotCapacity);
+
+    int descriptor = createSegment();
+    if(descriptor < 0) return;
+
+    if(ftruncate(descriptor, _mappingSize) == 0)
+    {
+        void* mapping = mmap(nullptr, _mappingSize, PROT_READ | PROT_WRITE,
+                             MAP_SHARED, descriptor, 0);
+        if(mapping != MAP_FAILED)
+            _mapping = static_cast<uint8_t*>(mapping);
+    }
+    ::close(descriptor);
+    if(!_mapping)
+    {
+        shm_unlink(_name.c_str());
+        return;
+    }
+
+    initRing();
+}
+
+int SharedFramePublisher::createSegment() const noexcept
+{
+    int descriptor = shm_open(_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if(descriptor >= 0 || errno != EEXIST) return descriptor;
+
+    retireSegment();
+    shm_unlink(_name.c_str());
+    return shm_open(_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+}
+
+void SharedFramePublisher::retireSegment() const noexcept
+{
+    int descriptor = shm_open(_name.c_str(), O_RDWR, 0);
+    if(descriptor < 0) return;
+
+    struct stat status;
+    if(fstat(descriptor, &status) == 0 &&
+       static_cast<size_t>(status.st_size) >= SharedFrameRing::headerSize())
+    {
+        void* mapping = mmap(nullptr, SharedFrameRing::headerSize(),
+                             PROT_READ | PROT_WRITE, MAP_SHARED,
+                             descriptor, 0);
+        if(mapping != MAP_FAILED)
+        {
+            SharedFrameRingHeader* header =
+                static_cast<SharedFrameRingHeader*>(mapping);
+            if(header->magic == SharedFrameRing::MAGIC &&
+               header->version == SharedFrameRing::VERSION)
+                header->generation.store(SharedFrameRing::RETIRED_GENERATION,
+                                         std::memory_order_release);
+            munmap(mapping, SharedFrameRing::headerSize());
+        }
+    }
+    ::close(descriptor);
+}
+
+void SharedFramePublisher::initRing() noexcept
+{
+    std::memset(_mapping, 0, _mappingSize);
+    for(uint32_t i = 0; i < _slotsAmount; i++)
+        new (SharedFrameRing::slot(_mapping, _slotCapacity, i, _slotsAmount))
+            SharedFrameSlot();
+
+    _generation = static_cast<uint64_t>(SharedFrameRing::now()) | 1;
+
+    SharedFrameRingHeader* header =
+        new (_mapping) SharedFrameRingHeader();
+    header->slotsAmount  = _slotsAmount;
+    header->slotCapacity = _slotCapacity;
+    header->version      = SharedFrameRing::VERSION;
+    header->generation.store(_generation, std::memory_order_relaxed);
+    header->latestFrameNumber.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic        = SharedFrameRing::MAGIC;
+}
+
+SharedFramePublisher::~SharedFramePublisher() noexcept
+{
+    close();
+}
+
+bool SharedFramePublisher::publish(const cv::Mat& frame) noexcept
+{
+    size_t size = frame.total() * frame.elemSize();
+    if(!_mapping || size > _slotCapacity) return false;
+
+    uint64_t frameNumber = _frameNumber + 1;
+    SharedFrameSlot* slot = SharedFrameRing::slot(_mapping, _slotCapacity,
+                                                  frameNumber, _slotsAmount);
+    uint64_t sequence = slot->sequence.load(std::memory_order_relaxed);
+
+    slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot->frameNumber = frameNumber;
+    slot->rows = frame.rows;
+    slot->cols = frame.cols;
+    slot->type = frame.type();
+    slot->size = static_cast<uint32_t>(size);
+
+    uint8_t* payload = SharedFrameRing::payload(slot);
+    if(frame.isContinuous())
+        std::memcpy(payload, frame.data, size);
+    else
+        for(int row = 0; row < frame.rows; row++)
+            std::memcpy(payload + row * frame.cols * frame.elemSize(),
+                        frame.ptr(row), frame.cols * frame.elemSize());
+
+    slot->publishTime = SharedFrameRing::now();
+    slot->sequence.store(sequence + 2, std::memory_order_release);
+
+    reinterpret_cast<SharedFrameRingHeader*>(_mapping)->latestFrameNumber
+        .store(frameNumber, std::memory_order_release);
+    _frameNumber = frameNumber;
+    return true;
+}
+
+void SharedFramePublisher::close() noexcept
+{
+    if(!_mapping) return;
+
+    reinterpret_cast<SharedFrameRingHeader*>(_mapping)->generation
+        .store(SharedFrameRing::RETIRED_GENERATION, std::memory_order_release);
+    munmap(_mapping, _mappingSize);
+    shm_unlink(_name.c_str());
+    _mapping = nullptr;
+}
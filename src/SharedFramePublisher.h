@@ -0,0 +1,46 @@
+#ifndef SHAREDFRAMEPUBLISHER_H
+#define SHAREDFRAMEPUBLISHER_H
+
+#include "SharedFrameRing.h"
+
+#include <opencv2/core/core.hpp>
+
+#include <string>
+
+class SharedFramePublisher
+{
+public:
+    SharedFramePublisher(const std::string& name,
+                         size_t slotCapacity,
+                         int slotsAmount = DEFAULT_SLOTS_AMOUNT) noexcept;
+    ~SharedFramePublisher() noexcept;
+
+    SharedFramePublisher(const SharedFramePublisher&) = delete;
+    SharedFramePublisher& operator=(const SharedFramePublisher&) = delete;
+
+    bool publish(const cv::Mat& frame) noexcept;
+
+    bool isOpen() const noexcept { return _mapping != nullptr; }
+    uint64_t publishedFrames() const noexcept { return _frameNumber; }
+    uint64_t generation() const noexcept { return _generation; }
+
+    static const int DEFAULT_SLOTS_AMOUNT = 4;
+
+private:
+    int createSegment() const noexcept;
+    void retireSegment() const noexcept;
+    void initRing() noexcept;
+    void close() noexcept;
+
+
+
+    std::string _name;
+    uint8_t* _mapping = nullptr;
+    size_t _mappingSize = 0;
+    uint32_t _slotsAmount;
+    uint32_t _slotCapacity;
+    uint64_t _frameNumber = 0;
+    uint64_t _generation = SharedFrameRing::RETIRED_GENERATION;
+};
+
+#endif // SHAREDFRAMEPUBLISHER_H
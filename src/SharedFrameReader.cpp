@@ -0,0 +1,145 @@
+#include "SharedFrameReader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SharedFrameReader::SharedFrameReader(const std::string& name) noexcept
+    : _name(name)
+{
+    open();
+}
+
+void SharedFrameReader::open() noexcept
+{
+    int descriptor = shm_open(_name.c_str(), O_RDONLY, 0);
+    if(descriptor < 0) return;
+
+    struct stat status;
+    if(fstat(descriptor, &status) == 0 &&
+       static_cast<size_t>(status.st_size) >= SharedFrameRing::headerSize())
+    {
+        void* mapping = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED,
+                             descriptor, 0);
+        if(mapping != MAP_FAILED)
+        {
+            _mapping = static_cast<uint8_t*>(mapping);
+            _mappingSize = status.st_size;
+        }
+    }
+    ::close(descriptor);
+    if(!_mapping) return;
+
+    const SharedFrameRingHeader* ringHeader = header();
+    uint32_t magic = ringHeader->magic;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(magic != SharedFrameRing::MAGIC ||
+       ringHeader->version != SharedFrameRing::VERSION ||
+       SharedFrameRing::mappingSize(ringHeader->slotsAmount,
+                                    ringHeader->slotCapacity) > _mappingSize)
+    {
+        close();
+        return;
+    }
+    _slotsAmount  = ringHeader->slotsAmount;
+    _slotCapacity = ringHeader->slotCapacity;
+    _generation   = ringHeader->generation.load(std::memory_order_acquire);
+}
+
+void SharedFrameReader::close() noexcept
+{
+    if(_mapping) munmap(_mapping, _mappingSize);
+    _mapping = nullptr;
+    _mappingSize = 0;
+}
+
+SharedFrameReader::~SharedFrameReader() noexcept
+{
+    close();
+}
+
+bool SharedFrameReader::isStale() const noexcept
+{
+    return !_mapping ||
+           _generation == SharedFrameRing::RETIRED_GENERATION ||
+           header()->generation.load(std::memory_order_acquire) !=
+           _generation;
+}
+
+bool SharedFrameReader::reopen() noexcept
+{
+    close();
+    open();
+    return !isStale();
+}
+
+uint64_t SharedFrameReader::latestFrameNumber() const noexcept
+{
+    if(isStale()) return 0;
+    return header()->latestFrameNumber.load(std::memory_order_acquire);
+}
+
+bool SharedFrameReader::acquireLatest(SharedFrame& frame) const noexcept
+{
+    for(int attempt = 0; attempt < MAX_ATTEMPTS; attempt++)
+    {
+        uint64_t frameNumber = latestFrameNumber();
+        if(frameNumber == 0) return false;
+
+        SharedFrameSlot* slot = SharedFrameRing::slot(
+            _mapping, _slotCapacity, frameNumber, _slotsAmount);
+        uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        if(sequence & 1) continue;
+
+        frame.frameNumber = slot->frameNumber;
+        frame.publishTime = slot->publishTime;
+        int rows = slot->rows, cols = slot->cols, type = slot->type;
+        uint32_t size = slot->size;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(slot->sequence.load(std::memory_order_relaxed) != sequence ||
+           frame.frameNumber != frameNumber || size > _slotCapacity)
+            continue;
+
+        frame.image = cv::Mat(rows, cols, type,
+                              SharedFrameRing::payload(slot));
+        frame.sequence = sequence;
+        frame.slot = slot;
+        return true;
+    }
+    return false;
+}
+
+bool SharedFrameReader::isIntact(const SharedFrame& frame) const noexcept
+{
+    if(!frame.slot) return false;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return frame.slot->sequence.load(std::memory_order_relaxed) ==
+           frame.sequence;
+}
+
+bool SharedFrameReader::copyLatest(cv::Mat& image, uint64_t& frameNumber)
+    const noexcept
+{
+    SharedFrame frame;
+
+    for(int attempt = 0; attempt < MAX_ATTEMPTS; attempt++)
+    {
+        if(!acquireLatest(frame)) return false;
+
+        frame.image.copyTo(image);
+        if(isIntact(frame))
+        {
+            frameNumber = frame.frameNumber;
+            return true;
+        }
+    }
+    return false;
+}
+
+const SharedFrameRingHeader* SharedFrameReader::header() const noexcept
+{
+    return reinterpret_cast<const SharedFrameRingHeader*>(_mapping);
+}
@@ -0,0 +1,54 @@
+#ifndef SHAREDFRAMEREADER_H
+#define SHAREDFRAMEREADER_H
+
+#include "SharedFrameRing.h"
+
+#include <opencv2/core/core.hpp>
+
+#include <string>
+
+struct SharedFrame
+{
+    cv::Mat image;
+    uint64_t frameNumber = 0;
+    uint64_t sequence    = 0;
+    int64_t publishTime  = 0;
+    const SharedFrameSlot* slot = nullptr;
+};
+
+class SharedFrameReader
+{
+public:
+    SharedFrameReader(const std::string& name) noexcept;
+    ~SharedFrameReader() noexcept;
+
+    SharedFrameReader(const SharedFrameReader&) = delete;
+    SharedFrameReader& operator=(const SharedFrameReader&) = delete;
+
+    bool isOpen() const noexcept { return _mapping != nullptr; }
+    bool isStale() const noexcept;
+    bool reopen() noexcept;
+    uint64_t latestFrameNumber() const noexcept;
+
+    bool acquireLatest(SharedFrame& frame) const noexcept;
+    bool isIntact(const SharedFrame& frame) const noexcept;
+    bool copyLatest(cv::Mat& image, uint64_t& frameNumber) const noexcept;
+
+private:
+    void open() noexcept;
+    void close() noexcept;
+    const SharedFrameRingHeader* header() const noexcept;
+
+
+
+    std::string _name;
+    uint8_t* _mapping = nullptr;
+    size_t _mappingSize = 0;
+    uint32_t _slotsAmount = 0;
+    uint32_t _slotCapacity = 0;
+    uint64_t _generation = SharedFrameRing::RETIRED_GENERATION;
+
+    const int MAX_ATTEMPTS = 8;
+};
+
+#endif // SHAREDFRAMEREADER_H
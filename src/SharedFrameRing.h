@@ -0,0 +1,81 @@
+#ifndef SHAREDFRAMERING_H
+#define SHAREDFRAMERING_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+struct SharedFrameRingHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slotsAmount;
+    uint32_t slotCapacity;
+    std::atomic<uint64_t> generation;
+    std::atomic<uint64_t> latestFrameNumber;
+};
+
+struct alignas(64) SharedFrameSlot
+{
+    std::atomic<uint64_t> sequence;
+    uint64_t frameNumber;
+    int64_t publishTime;
+    int32_t rows;
+    int32_t cols;
+    int32_t type;
+    uint32_t size;
+};
+
+namespace SharedFrameRing
+{
+    const uint32_t MAGIC   = 0x52465353;
+    const uint32_t VERSION = 2;
+    const uint64_t RETIRED_GENERATION = 0;
+    const size_t ALIGNMENT = 64;
+
+    inline size_t align(size_t size) noexcept
+    {
+        return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    inline size_t headerSize() noexcept
+    {
+        return align(sizeof(SharedFrameRingHeader));
+    }
+
+    inline size_t slotStride(uint32_t slotCapacity) noexcept
+    {
+        return align(sizeof(SharedFrameSlot)) + align(slotCapacity);
+    }
+
+    inline size_t mappingSize(uint32_t slotsAmount, uint32_t slotCapacity)
+        noexcept
+    {
+        return headerSize() + slotsAmount * slotStride(slotCapacity);
+    }
+
+    inline SharedFrameSlot* slot(uint8_t* mapping,
+                                 uint32_t slotCapacity,
+                                 uint64_t frameNumber,
+                                 uint32_t slotsAmount) noexcept
+    {
+        return reinterpret_cast<SharedFrameSlot*>(
+            mapping + headerSize() +
+            (frameNumber % slotsAmount) * slotStride(slotCapacity));
+    }
+
+    inline uint8_t* payload(SharedFrameSlot* slot) noexcept
+    {
+        return reinterpret_cast<uint8_t*>(slot) +
+               align(sizeof(SharedFrameSlot));
+    }
+
+    inline int64_t now() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+#endif // SHAREDFRAMERING_H
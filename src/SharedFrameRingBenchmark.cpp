@@ -0,0 +1,68 @@
+#include "SharedFrameRingBenchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <thread>
+
+SharedFrameRingBenchmark::SharedFrameRingBenchmark(const std::string& name)
+    noexcept
+    : _name(name)
+{
+}
+
+void SharedFrameRingBenchmark::run(const cv::Mat& frame, int framesAmount)
+    const noexcept
+{
+    SharedFramePublisher publisher(_name, frame.total() * frame.elemSize());
+    SharedFrameReader reader(_name);
+    if(!publisher.isOpen() || !reader.isOpen()) return;
+
+    std::atomic<bool> finished(false);
+    vector<double> latencies;
+    std::thread consumer([&]
+    {
+        uint64_t lastFrameNumber = 0;
+        SharedFrame sharedFrame;
+
+        while(!finished.load(std::memory_order_acquire))
+        {
+            if(!reader.acquireLatest(sharedFrame) ||
+               sharedFrame.frameNumber == lastFrameNumber)
+                continue;
+
+            int64_t received = SharedFrameRing::now();
+            if(!reader.isIntact(sharedFrame)) continue;
+
+            latencies.push_back((received - sharedFrame.publishTime) / 1000.0);
+            lastFrameNumber = sharedFrame.frameNumber;
+        }
+    });
+
+    for(int i = 0; i < framesAmount; i++)
+    {
+        publisher.publish(frame);
+        std::this_thread::sleep_for(
+            std::chrono::microseconds(PUBLISH_PERIOD_US));
+    }
+    finished.store(true, std::memory_order_release);
+    consumer.join();
+
+    showResults(latencies, framesAmount);
+}
+
+void SharedFrameRingBenchmark::showResults(const vector<double>& latencies,
+                                           int framesAmount) const noexcept
+{
+    if(latencies.empty()) return;
+
+    double average = std::accumulate(latencies.begin(), latencies.end(), 0.0) /
+                     latencies.size();
+    double maximum = *std::max_element(latencies.begin(), latencies.end());
+
+    std::cout << "Shared frame ring: "
+              << "received " << latencies.size() << " of " << framesAmount
+              << " frames, latency " << average << " us average, "
+              << maximum << " us max" << std::endl;
+}
@@ -0,0 +1,33 @@
+#ifndef SHAREDFRAMERINGBENCHMARK_H
+#define SHAREDFRAMERINGBENCHMARK_H
+
+#include "SharedFramePublisher.h"
+#include "SharedFrameReader.h"
+
+#include <opencv2/core/core.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using std::vector;
+
+class SharedFrameRingBenchmark
+{
+public:
+    SharedFrameRingBenchmark(const std::string& name) noexcept;
+
+    void run(const cv::Mat& frame, int framesAmount) const noexcept;
+
+private:
+    void showResults(const vector<double>& latencies,
+                     int framesAmount) const noexcept;
+
+
+
+    std::string _name;
+
+    const int PUBLISH_PERIOD_US = 1000;
+};
+
+#endif // SHAREDFRAMERINGBENCHMARK_H
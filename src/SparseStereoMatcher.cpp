@@ -0,0 +1,215 @@
+#include "SparseStereoMatcher.h"
+
+class RowFeatureMatcher : public cv::ParallelLoopBody
+{
+public:
+    RowFeatureMatcher(const cv::Mat& leftImage,
+                      const cv::Mat& rightImage,
+                      const vector<cv::KeyPoint>& features,
+                      vector<float>& disparities,
+                      int minDisparity,
+                      int maxDisparity,
+                      int blockRadius,
+                      int uniquenessRatio) noexcept
+        : _leftImage(leftImage),
+          _rightImage(rightImage),
+          _features(features),
+          _disparities(disparities),
+          _minDisparity(minDisparity),
+          _maxDisparity(maxDisparity),
+          _blockRadius(blockRadius),
+          _uniquenessRatio(uniquenessRatio)
+    {
+    }
+
+    void operator()(const cv::Range& range) const
+    {
+        vector<int> costs(_maxDisparity - _minDisparity + 1);
+
+        for(int i = range.start; i < range.end; i++)
+            _disparities[i] = matchFeature(_features[i].pt, costs);
+    }
+
+private:
+    float matchFeature(const cv::Point2f& feature, vector<int>& costs) const
+    {
+        int x = cvRound(feature.x), y = cvRound(feature.y);
+
+        if(y < _blockRadius || y >= _leftImage.rows - _blockRadius ||
+           x < _blockRadius || x >= _leftImage.cols - _blockRadius)
+            return -1;
+
+        int firstDisparity = std::max(_minDisparity,
+                                      x + _blockRadius - _rightImage.cols + 1);
+        int lastDisparity  = std::min(_maxDisparity, x - _blockRadius);
+        if(lastDisparity < firstDisparity) return -1;
+
+        int bestDisparity = firstDisparity;
+        for(int d = firstDisparity; d <= lastDisparity; d++)
+        {
+            costs[d - _minDisparity] = blockCost(x, y, d);
+            if(costs[d - _minDisparity] < costs[bestDisparity - _minDisparity])
+                bestDisparity = d;
+        }
+
+        int bestCost = costs[bestDisparity - _minDisparity];
+        for(int d = firstDisparity; d <= lastDisparity; d++)
+            if(std::abs(d - bestDisparity) > 1 &&
+               costs[d - _minDisparity] * 100 <
+               bestCost * (100 + _uniquenessRatio))
+                return -1;
+
+        return bestDisparity + subpixelOffset(costs,
+                                              firstDisparity - _minDisparity,
+                                              bestDisparity - _minDisparity,
+                                              lastDisparity - _minDisparity);
+    }
+
+    int blockCost(int x, int y, int disparity) const
+    {
+        int cost = 0;
+
+        for(int dy = -_blockRadius; dy <= _blockRadius; dy++)
+        {
+            const uchar* left  = _leftImage.ptr<uchar>(y + dy) + x;
+            const uchar* right = _rightImage.ptr<uchar>(y + dy) + x - disparity;
+            for(int dx = -_blockRadius; dx <= _blockRadius; dx++)
+                cost += std::abs(left[dx] - right[dx]);
+        }
+        return cost;
+    }
+
+    float subpixelOffset(const vector<int>& costs,
+                         int first, int best, int last) const
+    {
+        if(best == first || best == last) return 0;
+
+        int denominator = costs[best - 1] - 2 * costs[best] + costs[best + 1];
+        if(denominator <= 0) return 0;
+        return 0.5f * (costs[best - 1] - costs[best + 1]) / denominator;
+    }
+
+    const cv::Mat& _leftImage;
+    const cv::Mat& _rightImage;
+    const vector<cv::KeyPoint>& _features;
+    vector<float>& _disparities;
+    int _minDisparity;
+    int _maxDisparity;
+    int _blockRadius;
+    int _uniquenessRatio;
+};
+
+SparseStereoMatcher::SparseStereoMatcher(
+        const StereoCalibrationData& calibrationData) noexcept
+    : _projectionMatrix1(calibrationData.projectionMatrix1()),
+      _projectionMatrix2(calibrationData.projectionMatrix2())
+{
+}
+
+SparseStereoMatcher::SparseStereoMatcher(
+        const std::string& pathToProjectionMatrices) noexcept
+{
+    StereoCalibrationData calibrationData(0, 0, 0);
+
+    calibrationData.loadProjectionMatrices(pathToProjectionMatrices);
+    _projectionMatrix1 = calibrationData.projectionMatrix1();
+    _projectionMatrix2 = calibrationData.projectionMatrix2();
+}
+
+const vector<cv::Point3f>& SparseStereoMatcher::computePoints(
+        const cv::Mat& leftImage, const cv::Mat& rightImage) noexcept
+{
+    detectFeatures(leftImage);
+    matchFeaturesAlongRows(leftImage, rightImage);
+    triangulateMatches();
+    return _points;
+}
+
+void SparseStereoMatcher::detectFeatures(const cv::Mat& leftImage) noexcept
+{
+    _features.clear();
+    cv::FAST(leftImage, _features, _fastThreshold, true);
+
+    if(_features.size() > static_cast<size_t>(_maxFeaturesAmount))
+    {
+        std::nth_element(_features.begin(),
+                         _features.begin() + _maxFeaturesAmount,
+                         _features.end(),
+                         [](const cv::KeyPoint& first,
+                            const cv::KeyPoint& second)
+                         { return first.response > second.response; });
+        _features.resize(_maxFeaturesAmount);
+    }
+}
+
+void SparseStereoMatcher::matchFeaturesAlongRows(const cv::Mat& leftImage,
+                                                 const cv::Mat& rightImage)
+    noexcept
+{
+    _disparities.resize(_features.size());
+    cv::parallel_for_(cv::Range(0, _features.size()),
+                      RowFeatureMatcher(leftImage,
+                                        rightImage,
+                                        _features,
+                                        _disparities,
+                                        _minDisparity,
+                                        _maxDisparity,
+                                        BLOCK_RADIUS,
+                                        UNIQUENESS_RATIO));
+
+    _leftPoints.clear();
+    _rightPoints.clear();
+    for(size_t i = 0; i < _features.size(); i++)
+    {
+        if(_disparities[i] < 0) continue;
+        _leftPoints.push_back(_features[i].pt);
+        _rightPoints.push_back(cv::Point2f(_features[i].pt.x - _disparities[i],
+                                           _features[i].pt.y));
+    }
+}
+
+void SparseStereoMatcher::triangulateMatches() noexcept
+{
+    _points.clear();
+    if(_leftPoints.empty()) return;
+
+    cv::Mat homogeneousPoints;
+    cv::triangulatePoints(_projectionMatrix1, _projectionMatrix2,
+                          cv::Mat(_leftPoints).reshape(1).t(),
+                          cv::Mat(_rightPoints).reshape(1).t(),
+                          homogeneousPoints);
+    cv::convertPointsFromHomogeneous(homogeneousPoints.t(), _points);
+}
+
+void SparseStereoMatcher::savePointsWithPlyExtension() const noexcept
+{
+    std::ofstream outputFile(OUTPUT_FILENAME, std::ofstream::out);
+
+    outputFile << "ply" << std::endl;
+    outputFile << "format ascii 1.0" << std::endl;
+    outputFile << "element vertex " << _points.size() << std::endl;
+    outputFile << "property float32 x" << std::endl;
+    outputFile << "property float32 y" << std::endl;
+    outputFile << "property float32 z" << std::endl;
+    outputFile << "end_header" << std::endl;
+    for(auto& point : _points)
+        outputFile << point.x << " " << point.y << " " << point.z << std::endl;
+    std::cout << "Point cloud saved to " << OUTPUT_FILENAME << std::endl;
+}
+
+void SparseStereoMatcher::setFastThreshold(int fastThreshold) noexcept
+{
+    _fastThreshold = fastThreshold;
+}
+
+void SparseStereoMatcher::setMaxFeaturesAmount(int maxFeaturesAmount) noexcept
+{
+    _maxFeaturesAmount = maxFeaturesAmount;
+}
+
+void SparseStereoMatcher::setDisparityRange(int minDisparity, int maxDisparity)
+    noexcept
+{
+    _minDisparity = std::min(minDisparity, maxDisparity);
+    _maxDisparity = std::max(minDisparity, maxDisparity);
+}
@@ -0,0 +1,62 @@
+#ifndef SPARSESTEREOMATCHER_H
+#define SPARSESTEREOMATCHER_H
+
+#include "StereoCalibrationData.h"
+
+#include <opencv2/imgproc/imgproc.hpp>
+#include <opencv2/calib3d/calib3d.hpp>
+#include <opencv2/features2d/features2d.hpp>
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+
+using std::vector;
+
+class SparseStereoMatcher
+{
+public:
+    SparseStereoMatcher(const StereoCalibrationData& calibrationData) noexcept;
+    SparseStereoMatcher(const std::string& pathToProjectionMatrices) noexcept;
+
+    const vector<cv::Point3f>& computePoints(const cv::Mat& leftImage,
+                                             const cv::Mat& rightImage)
+        noexcept;
+
+    void savePointsWithPlyExtension() const noexcept;
+
+    void setFastThreshold(int fastThreshold) noexcept;
+    void setMaxFeaturesAmount(int maxFeaturesAmount) noexcept;
+    void setDisparityRange(int minDisparity, int maxDisparity) noexcept;
+
+private:
+    void detectFeatures(const cv::Mat& leftImage) noexcept;
+    void matchFeaturesAlongRows(const cv::Mat& leftImage,
+                                const cv::Mat& rightImage) noexcept;
+    void triangulateMatches() noexcept;
+
+
+
+    cv::Mat _projectionMatrix1;
+    cv::Mat _projectionMatrix2;
+
+    vector<cv::KeyPoint> _features;
+    vector<float> _disparities;
+    vector<cv::Point2f> _leftPoints;
+    vector<cv::Point2f> _rightPoints;
+    vector<cv::Point3f> _points;
+
+    int _fastThreshold     = 20;
+    int _maxFeaturesAmount = 500;
+    int _minDisparity      = 0;
+    int _maxDisparity      = 128;
+
+    const int BLOCK_RADIUS = 3;
+    const int UNIQUENESS_RATIO = 15;
+
+    const std::string OUTPUT_FILENAME = "sparse_points.ply";
+};
+
+#endif // SPARSESTEREOMATCHER_H
@@ -89,3 +89,12 @@ void StereoCalibrationData::saveD2DMappingMatrixWithYmlExtension(
     fileStorage << D2D_MAPPING_MATRIX_TITLE  << _d2DMappingMatrix;
     fileStorage.release();
 }
+
+void StereoCalibrationData::loadProjectionMatrices(const std::string &path)
+        noexcept
+{
+    cv::FileStorage fileStorage(path, cv::FileStorage::READ);
+    fileStorage[PROJECTION_MATRIX_1_TITLE] >> _projectionMatrix1;
+    fileStorage[PROJECTION_MATRIX_2_TITLE] >> _projectionMatrix2;
+    fileStorage.release();
+}
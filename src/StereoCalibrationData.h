@@ -65,6 +65,8 @@ public:
     void saveD2DMappingMatrixWithYmlExtension(const std::string &path)
         const noexcept;
 
+    void loadProjectionMatrices(const std::string &path) noexcept;
+
 private:
     cv::Mat _stereoRotation     = cv::Mat(3, 3, CV_32FC1);
     cv::Mat _stereoTranslation  = cv::Mat(3, 1, CV_32FC1);
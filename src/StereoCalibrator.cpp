@@ -21,21 +21,45 @@ StereoCalibrator::StereoCalibrator(const std::string imagesLeft,
     initIntrinsicsAndDistortions();
 }
 
-void StereoCalibrator::execute() noexcept
+bool StereoCalibrator::execute() noexcept
 {
-    loadSingleCalibrationResults("intrinsic_matrixL.yml",
-                                 "distortion_coeffsL.yml",
-                                 "intrinsic_matrixR.yml",
-                                 "distortion_coeffsR.yml");
+    loadSingleCalibrationResults(INTRINSIC_MATRIX_LEFT_FILE,
+                                 DISTORTION_COEFFS_LEFT_FILE,
+                                 INTRINSIC_MATRIX_RIGHT_FILE,
+                                 DISTORTION_COEFFS_RIGHT_FILE);
 
     setDisplayCorners(false);
-    findAllCorners();
+    try{ findAllCorners(); }
+    catch(InterruptedByUser) { return false; }
+    if(!hasEnoughViews()) return false;
 
+    calibrateAndRectify();
+    return true;
+}
+
+bool StereoCalibrator::executeEndToEnd() noexcept
+{
+    CornerStore monoPoints[2];
+
+    try{ findAllCornersOnce(monoPoints); }
+    catch(InterruptedByUser) { return false; }
+    if(!hasEnoughViews()) return false;
+    calibrateMonoCamerasConcurrently(monoPoints);
+
+    calibrateAndRectify();
+    return true;
+}
+
+void StereoCalibrator::calibrateAndRectify() noexcept
+{
     calibrateCameras();
     showAverageCalibrationError();
 
     initOutputMapsAndImages();
-    computeAndDisplayRectification();
+    if(_headless)
+        computeRectification();
+    else
+        computeAndDisplayRectification();
 
     saveCalibrationResults();
 }
@@ -51,156 +75,233 @@ void StereoCalibrator::rectifyAndDisplayAllImages() noexcept
     _captureLeft.open(_imagesLeft);
     _captureRight.open(_imagesRight);
 
+    initPreviewMapsAndImage();
+
     for(int i = 0; i < _calibrationData.imagesAmount(); i++)
     {
-        auto firstGrayImage  = captureLeftGrayImage();
-        auto secondGrayImage = captureRightGrayImage();
+        _captureLeft.read(_leftFrame);
+        _captureRight.read(_rightFrame);
 
-        if(!firstGrayImage.empty() && !secondGrayImage.empty())
-            prepareAndDisplayPairImage(firstGrayImage, secondGrayImage);
+        if(!_leftFrame.empty() && !_rightFrame.empty())
+            prepareAndDisplayPairImage();
+        if(handlePause() == ESCAPE_KEY) break;
     }
 }
 
-cv::Mat StereoCalibrator::captureLeftGrayImage() noexcept
+void StereoCalibrator::initPreviewMapsAndImage() noexcept
 {
-    cv::Mat image, grayImage(_image->size(), CV_8UC3);
+    cv::Size previewSize(_image->size().width * RESIZE_FACTOR,
+                         _image->size().height * RESIZE_FACTOR);
+    cv::Mat mapX, mapY;
+
+    _rectifyMapGenerator.generate(
+        _calibrationData.intrinsic(LEFT),
+        _calibrationData.distortion(LEFT),
+        _calibrationData.rectTransform1(),
+        scaledCameraMatrix(_newCameraMatrix1),
+        previewSize, mapX, mapY);
+    _previewUndistorterLeft = Undistorter(mapX, mapY);
 
-    _captureLeft.read(image);
-    cv::cvtColor(image, grayImage, CV_BGR2GRAY);
+    _rectifyMapGenerator.generate(
+        _calibrationData.intrinsic(RIGHT),
+        _calibrationData.distortion(RIGHT),
+        _calibrationData.rectTransform2(),
+        scaledCameraMatrix(_newCameraMatrix2),
+        previewSize, mapX, mapY);
+    _previewUndistorterRight = Undistorter(mapX, mapY);
 
-    return grayImage;
+    _pairImage = MatSharedPtr(new cv::Mat(previewSize.height,
+                                          previewSize.width * 2,
+                                          CV_8UC3));
 }
 
-cv::Mat StereoCalibrator::captureRightGrayImage() noexcept
+cv::Mat StereoCalibrator::scaledCameraMatrix(const cv::Mat& cameraMatrix)
+    const noexcept
 {
-    cv::Mat image, grayImage(_image->size(), CV_8UC3);
-
-    _captureRight.read(image);
-    cv::cvtColor(image, grayImage, CV_BGR2GRAY);
+    cv::Mat matrix;
 
-    return grayImage;
+    cameraMatrix.colRange(0, 3).convertTo(matrix, CV_64F);
+    return pixelScaleMatrix(RESIZE_FACTOR) * matrix;
 }
 
-void StereoCalibrator::prepareAndDisplayPairImage(
-        const cv::Mat& firstGrayImage,
-        const cv::Mat& secondGrayImage) const noexcept
+void StereoCalibrator::prepareAndDisplayPairImage() noexcept
 {
-    auto resizedPairImageHeight = _image->size().height * RESIZE_FACTOR;
-    auto resizedPairImageWidth  = _image->size().width * 2 * RESIZE_FACTOR;
-    auto pairImage
-        = createPairImage(resizeImage(remapImage(firstGrayImage,
-                                                 *_rectifyMapX1,
-                                                 *_rectifyMapY1)),
-                          resizeImage(remapImage(secondGrayImage,
-                                                 *_rectifyMapX2,
-                                                 *_rectifyMapY2)),
-                          cv::Size(resizedPairImageWidth,
-                                   resizedPairImageHeight));
+    auto halfOfWidth = _pairImage->cols / 2;
+    cv::Mat leftHalf  = _pairImage->colRange(0, halfOfWidth);
+    cv::Mat rightHalf = _pairImage->colRange(halfOfWidth, _pairImage->cols);
+
+    _previewUndistorterLeft.apply(_leftFrame, leftHalf);
+    _previewUndistorterRight.apply(_rightFrame, rightHalf);
 
-    pairImage = createImageWithHorizontalLines(pairImage);
+    drawHorizontalLines(*_pairImage);
 
     DisplayManager::showImages(
-        {std::make_tuple("rectified",
-                         std::make_shared<cv::Mat>(pairImage),
-                         5000)});
+        {std::make_tuple("rectified", _pairImage, PAIR_IMAGE_SHOWING_TIME)});
 }
 
-cv::Mat StereoCalibrator::createImageWithHorizontalLines(const cv::Mat& image)
-    const noexcept
+void StereoCalibrator::drawHorizontalLines(cv::Mat& image) const noexcept
 {
-    auto resultImage = image.clone();
-    auto resizedImageWidth = _image->size().width * 2 * RESIZE_FACTOR;
-    auto resizedImageHeight = image.size().height;
     auto jump = 16 * RESIZE_FACTOR;
 
-    for(size_t j = 0; j < resizedImageHeight; j += jump)
-        cv::line(resultImage,
+    for(float j = 0; j < image.rows; j += jump)
+        cv::line(image,
                  cv::Point(0, j),
-                 cv::Point(resizedImageWidth, j),
+                 cv::Point(image.cols, j),
                  CV_RGB(0, 255, 0));
+}
+
+void StereoCalibrator::useBouguetsMethod() noexcept
+{
+    _isBouguetsMethodChoosen = true;
+}
 
-    return resultImage;
+void StereoCalibrator::useHartleyMethod() noexcept
+{
+    _isBouguetsMethodChoosen = false;
 }
-cv::Mat StereoCalibrator::createPairImage(const cv::Mat& leftImage,
-                                          const cv::Mat& rightImage,
-                                          const cv::Size& size) const noexcept
+
+RectifyMaps StereoCalibrator::rectifyMaps() const noexcept
 {
-    cv::Mat pairImage(size, CV_8UC3);
-    auto convertedLeftImage  = convertToBGRImage(leftImage, leftImage.size());
-    auto convertedRightImage = convertToBGRImage(rightImage, rightImage.size());
-    auto halfOfWidth = size.width / 2;
+    RectifyMaps maps;
 
-    convertedLeftImage.copyTo(columnRange(pairImage, 0, halfOfWidth));
-    convertedRightImage.copyTo(columnRange(pairImage, halfOfWidth, size.width));
+    maps.leftX  = *_rectifyMapX1;
+    maps.leftY  = *_rectifyMapY1;
+    maps.rightX = *_rectifyMapX2;
+    maps.rightY = *_rectifyMapY2;
+    return maps;
+}
 
-    return pairImage;
+void StereoCalibrator::useRectifyMapsCache(const std::string& cacheDirectory)
+    noexcept
+{
+    _rectifyMapGenerator.useCache(cacheDirectory);
 }
 
-cv::Mat StereoCalibrator::convertToBGRImage(const cv::Mat& grayImage,
-                                            const cv::Size& newImageSize)
-    const noexcept
+void StereoCalibrator::addRectificationProfile(const std::string& name,
+                                               double scale) noexcept
 {
-    cv::Mat bgrImage(newImageSize, CV_8UC3);
+    RectificationProfile profile;
 
-    cv::cvtColor(grayImage, bgrImage, CV_GRAY2BGR);
+    profile.name = name;
+    profile.scale = scale;
+    _rectificationProfiles.push_back(profile);
+}
 
-    return bgrImage;
+const RectificationProfile* StereoCalibrator::rectificationProfile(
+        const std::string& name) const noexcept
+{
+    for(auto& profile : _rectificationProfiles)
+        if(profile.name == name) return &profile;
+    return nullptr;
 }
 
-cv::Mat StereoCalibrator::columnRange(const cv::Mat& image,
-                                      const int startColumn,
-                                      const int endColumn) const noexcept
+void StereoCalibrator::computeRectification() noexcept
 {
-    return image.colRange(startColumn, endColumn);
+    if(_isBouguetsMethodChoosen)
+        bouguetsMethod();
+    else
+        hartleysMethod();
+    saveRectifyMaps();
+    computeRectificationProfiles();
 }
 
-cv::Mat StereoCalibrator::remapImage(const cv::Mat& image,
-                                     const cv::Mat& rectifyMapX1,
-                                     const cv::Mat& rectifyMapY1)
-    const noexcept
+void StereoCalibrator::computeRectificationProfiles() noexcept
 {
-    cv::Mat remappedImage;
+    for(auto& profile : _rectificationProfiles)
+    {
+        computeRectificationProfile(profile);
+        saveRectificationProfile(profile);
+    }
+}
 
-    cv::remap(image,
-              remappedImage,
-              rectifyMapX1,
-              rectifyMapY1,
-              cv::INTER_LINEAR);
+void StereoCalibrator::computeRectificationProfile(
+        RectificationProfile& profile) noexcept
+{
+    profile.imageSize = cv::Size(cvRound(_image->cols * profile.scale),
+                                 cvRound(_image->rows * profile.scale));
+    profile.projectionMatrix1 =
+        scaledProjectionMatrix(_newCameraMatrix1, profile.scale);
+    profile.projectionMatrix2 =
+        scaledProjectionMatrix(_newCameraMatrix2, profile.scale);
+    if(_isBouguetsMethodChoosen)
+        profile.d2DMappingMatrix = scaledD2DMappingMatrix(
+            _calibrationData.d2DMappingMatrix(), profile.scale);
 
-    return remappedImage;
+    auto leftMaps = std::async(std::launch::async, [&]()
+    {
+        _rectifyMapGenerator.generate(
+            _calibrationData.intrinsic(LEFT),
+            _calibrationData.distortion(LEFT),
+            _calibrationData.rectTransform1(),
+            profile.projectionMatrix1,
+            profile.imageSize, profile.maps.leftX, profile.maps.leftY);
+    });
+    _rectifyMapGenerator.generate(
+        _calibrationData.intrinsic(RIGHT),
+        _calibrationData.distortion(RIGHT),
+        _calibrationData.rectTransform2(),
+        profile.projectionMatrix2,
+        profile.imageSize, profile.maps.rightX, profile.maps.rightY);
+    leftMaps.wait();
 }
 
-cv::Mat StereoCalibrator::resizeImage(const cv::Mat& image)
-    const noexcept
+void StereoCalibrator::saveRectificationProfile(
+        const RectificationProfile& profile) const noexcept
 {
-    cv::Mat resizedImage;
+    cv::FileStorage fileStorage(
+        PROFILE_RECTIFY_MAPS_PREFIX + profile.name + YML_EXTENSION,
+        cv::FileStorage::WRITE);
+    fileStorage << RECTIFY_MAP_X1_TITLE << profile.maps.leftX;
+    fileStorage << RECTIFY_MAP_Y1_TITLE << profile.maps.leftY;
+    fileStorage << RECTIFY_MAP_X2_TITLE << profile.maps.rightX;
+    fileStorage << RECTIFY_MAP_Y2_TITLE << profile.maps.rightY;
+    fileStorage.release();
 
-    cv::resize(image,
-               resizedImage,
-               cv::Size(_image->size().width * RESIZE_FACTOR,
-                        _image -> size().height * RESIZE_FACTOR),
-               cv::INTER_AREA);
+    StereoCalibrationData profileData(_calibrationData);
+    profileData.setProjectionMatrices(profile.projectionMatrix1,
+                                      profile.projectionMatrix2);
+    profileData.saveProjectionMatricesWithYmlExtension(
+        PROFILE_PROJECTION_MATRICES_PREFIX + profile.name + YML_EXTENSION);
+    if(profile.d2DMappingMatrix.empty()) return;
 
-    return resizedImage;
+    profileData.setD2DMappingMatrix(profile.d2DMappingMatrix);
+    profileData.saveD2DMappingMatrixWithYmlExtension(
+        PROFILE_D2D_MAPPING_MATRIX_PREFIX + profile.name + YML_EXTENSION);
 }
 
-void StereoCalibrator::useBouguetsMethod() noexcept
+cv::Mat StereoCalibrator::pixelScaleMatrix(double scale) const noexcept
 {
-    _isBouguetsMethodChoosen = true;
+    cv::Mat scaleMatrix = cv::Mat::eye(3, 3, CV_64F);
+
+    scaleMatrix.at<double>(0, 0) = scale;
+    scaleMatrix.at<double>(1, 1) = scale;
+    scaleMatrix.at<double>(0, 2) = 0.5 * (scale - 1);
+    scaleMatrix.at<double>(1, 2) = 0.5 * (scale - 1);
+    return scaleMatrix;
 }
 
-void StereoCalibrator::useHartleyMethod() noexcept
+cv::Mat StereoCalibrator::scaledProjectionMatrix(
+        const cv::Mat& projectionMatrix, double scale) const noexcept
 {
-    _isBouguetsMethodChoosen = false;
+    cv::Mat projection;
+
+    projectionMatrix.convertTo(projection, CV_64F);
+    return pixelScaleMatrix(scale) * projection;
 }
 
-void StereoCalibrator::computeRectification() noexcept
+cv::Mat StereoCalibrator::scaledD2DMappingMatrix(
+        const cv::Mat& d2DMappingMatrix, double scale) const noexcept
 {
-    if(_isBouguetsMethodChoosen)
-        bouguetsMethod();
-    else
-        hartleysMethod();
-    saveRectifyMaps();
+    cv::Mat d2DMapping;
+    cv::Mat toFullResolution = cv::Mat::eye(4, 4, CV_64F);
+
+    for(int i = 0; i < 3; i++)
+        toFullResolution.at<double>(i, i) = 1 / scale;
+    toFullResolution.at<double>(0, 3) = -0.5 * (scale - 1) / scale;
+    toFullResolution.at<double>(1, 3) = -0.5 * (scale - 1) / scale;
+
+    d2DMappingMatrix.convertTo(d2DMapping, CV_64F);
+    return d2DMapping * toFullResolution;
 }
 
 void StereoCalibrator::saveRectifyMaps() const noexcept
@@ -217,18 +318,25 @@ void StereoCalibrator::precomputeMapForRemap(
                                     const cv::Mat& cameraMatrix1,
                                     const cv::Mat& cameraMatrix2) noexcept
 {
-    cv::initUndistortRectifyMap(
-        _calibrationData.intrinsic(LEFT),
-        _calibrationData.distortion(LEFT),
-        _calibrationData.rectTransform1(),
-        cameraMatrix1,
-        _image -> size(), CV_32F, *_rectifyMapX1, *_rectifyMapY1);
-    cv::initUndistortRectifyMap(
+    _newCameraMatrix1 = cameraMatrix1.clone();
+    _newCameraMatrix2 = cameraMatrix2.clone();
+
+    auto leftMaps = std::async(std::launch::async, [&]()
+    {
+        _rectifyMapGenerator.generate(
+            _calibrationData.intrinsic(LEFT),
+            _calibrationData.distortion(LEFT),
+            _calibrationData.rectTransform1(),
+            cameraMatrix1,
+            _image -> size(), *_rectifyMapX1, *_rectifyMapY1);
+    });
+    _rectifyMapGenerator.generate(
         _calibrationData.intrinsic(RIGHT),
         _calibrationData.distortion(RIGHT),
         _calibrationData.rectTransform2(),
         cameraMatrix2,
-        _image -> size(), CV_32F, *_rectifyMapX2, *_rectifyMapY2);
+        _image -> size(), *_rectifyMapX2, *_rectifyMapY2);
+    leftMaps.wait();
 }
 
 void StereoCalibrator::bouguetsMethod()
@@ -254,28 +362,18 @@ void StereoCalibrator::bouguetsMethod()
                           _calibrationData.projectionMatrix2());
 }
 
-void StereoCalibrator::initializeAllImagesPoint()
-{
-    for (int i=0; i<2; i++)
-        for (int j=0; j<_calibrationData.imagesAmount(); j++)
-            std::copy(_points[i][j].begin(), _points[i][j].end(),
-                      back_inserter(_allImagesPoints[i]));
-}
-
 void StereoCalibrator::hartleysMethod()
 {
     cv::Mat homographyMatrix1(3, 3, CV_32FC1);
     cv::Mat homographyMatrix2(3, 3, CV_32FC1);
 
-    initializeAllImagesPoint();
-
     _calibrationData.setFundamentalMatrix(
-        cv::findFundamentalMat(_allImagesPoints[LEFT],
-                               _allImagesPoints[RIGHT]));
+        cv::findFundamentalMat(_points[LEFT].allPoints(),
+                               _points[RIGHT].allPoints()));
 
     cv::stereoRectifyUncalibrated(
-        _allImagesPoints[LEFT],
-        _allImagesPoints[RIGHT],
+        _points[LEFT].allPoints(),
+        _points[RIGHT].allPoints(),
         _calibrationData.fundamentalMatrix(),
         _image -> size(),
         homographyMatrix1, homographyMatrix2, 3);
@@ -336,7 +434,8 @@ void StereoCalibrator::saveCalibrationResults() const noexcept
                 D2D_MAPPING_MATRIX_OUTPUT_FILE);
 }
 
-void StereoCalibrator::chooseNextImage(const int leftOrRight) noexcept
+void StereoCalibrator::chooseNextImage(const int leftOrRight)
+    throw (ImageReadError)
 {
     if (leftOrRight == LEFT)
         _image = nextImage(_captureLeft);
@@ -344,20 +443,148 @@ void StereoCalibrator::chooseNextImage(const int leftOrRight) noexcept
         _image = nextImage(_captureRight);
 }
 
-void StereoCalibrator::findAllCorners() noexcept
+void StereoCalibrator::findAllCorners() throw (InterruptedByUser)
 {
-    if(_displayCorners) DisplayManager::createWindows({CORNERS_WINDOW_TITLE});
+    if(shouldDisplayCorners())
+        DisplayManager::createWindows({CORNERS_WINDOW_TITLE});
 
     int leftOrRight;
 
+    for (int i = 0; i < 2; i++)
+        _points[i].reserve(_calibrationData.imagesAmount(),
+                           _calibrationData.pointsOnBoardAmount());
     for (int i = 0; i < _calibrationData.imagesAmount() * 2; i++)
     {
         leftOrRight = i % 2;
-        chooseNextImage(leftOrRight);
+        try{ chooseNextImage(leftOrRight); }
+        catch(ImageReadError)
+        {
+            std::cout << END_OF_STREAM << i / 2 << std::endl;
+            keepCommonViews();
+            break;
+        }
         _grayImage = createGrayImage();
         findCornersOnImage(_calibrationData,
                            _points[leftOrRight]);
+        if(leftOrRight == RIGHT && _progressCallback)
+            reportProgress(i / 2 + 1, _calibrationData.imagesAmount());
+        checkInterruptionCallback();
+    }
+    saveCornersCache();
+}
+
+void StereoCalibrator::findAllCornersOnce(CornerStore monoPoints[])
+    throw (InterruptedByUser)
+{
+    vector<cv::Point2f> corners[2];
+    cv::Mat grayImages[2];
+
+    for (int i = 0; i < 2; i++)
+    {
+        monoPoints[i].reserve(_calibrationData.imagesAmount(),
+                              _calibrationData.pointsOnBoardAmount());
+        _points[i].reserve(_calibrationData.imagesAmount(),
+                           _calibrationData.pointsOnBoardAmount());
     }
+    for (int i = 0; i < _calibrationData.imagesAmount(); i++)
+    {
+        MatSharedPtr rightImage;
+        try
+        {
+            rightImage = nextImage(_captureRight);
+            _image = nextImage(_captureLeft);
+        }
+        catch(ImageReadError)
+        {
+            std::cout << END_OF_STREAM << i << std::endl;
+            break;
+        }
+
+        auto rightDetection = std::async(std::launch::async, [&]()
+        {
+            return detectCorners(*rightImage, _calibrationData.boardSize(),
+                                 grayImages[RIGHT], corners[RIGHT]);
+        });
+        bool isFound[2];
+        isFound[LEFT]  = detectCorners(*_image, _calibrationData.boardSize(),
+                                       grayImages[LEFT], corners[LEFT]);
+        isFound[RIGHT] = rightDetection.get();
+
+        for (int side = 0; side < 2; side++)
+            if (isFound[side]) monoPoints[side].addView(corners[side]);
+        if (isFound[LEFT] && isFound[RIGHT])
+        {
+            _points[LEFT].addView(corners[LEFT]);
+            _points[RIGHT].addView(corners[RIGHT]);
+            _objectPoints.addView(boardPoints(_calibrationData));
+        }
+        if(_progressCallback)
+            reportProgress(i + 1, _calibrationData.imagesAmount());
+        checkInterruptionCallback();
+    }
+    saveCornersCache();
+}
+
+void StereoCalibrator::keepCommonViews() noexcept
+{
+    size_t viewsAmount = std::min(_objectPoints.viewsAmount(),
+                                  std::min(_points[LEFT].viewsAmount(),
+                                           _points[RIGHT].viewsAmount()));
+    vector<int> views(viewsAmount);
+
+    for (size_t view = 0; view < viewsAmount; view++)
+        views[view] = view;
+    _points[LEFT].keepViews(views);
+    _points[RIGHT].keepViews(views);
+    _objectPoints.keepViews(views);
+}
+
+bool StereoCalibrator::hasEnoughViews() const noexcept
+{
+    if(_image && _points[LEFT].viewsAmount() > 0) return true;
+
+    std::cout << NOT_ENOUGH_VIEWS << std::endl;
+    return false;
+}
+
+void StereoCalibrator::calibrateMonoCamerasConcurrently(
+        const CornerStore monoPoints[]) noexcept
+{
+    Calibrator leftCalibrator(_calibrationData.imagesAmount(),
+                              _calibrationData.boardWidth(),
+                              _calibrationData.boardHeight());
+    Calibrator rightCalibrator(_calibrationData.imagesAmount(),
+                               _calibrationData.boardWidth(),
+                               _calibrationData.boardHeight());
+    for(Calibrator* calibrator : {&leftCalibrator, &rightCalibrator})
+    {
+        calibrator->setSquareSize(_squareSize);
+        calibrator->setPattern(_pattern);
+        calibrator->useCornersCache(_cornersCache);
+    }
+
+    auto leftCalibration = std::async(std::launch::async, [&]()
+    {
+        leftCalibrator.calibrateFromCorners(monoPoints[LEFT], _image -> size());
+    });
+    rightCalibrator.calibrateFromCorners(monoPoints[RIGHT], _image -> size());
+    leftCalibration.wait();
+
+    _calibrationData.setIntrinsic(
+        leftCalibrator.calibrationData().intrinsic(0), LEFT);
+    _calibrationData.setDistortion(
+        leftCalibrator.calibrationData().distortion(0), LEFT);
+    _calibrationData.setIntrinsic(
+        rightCalibrator.calibrationData().intrinsic(0), RIGHT);
+    _calibrationData.setDistortion(
+        rightCalibrator.calibrationData().distortion(0), RIGHT);
+
+    leftCalibrator.saveSingleCalibrationResults(INTRINSIC_MATRIX_LEFT_FILE,
+                                                DISTORTION_COEFFS_LEFT_FILE,
+                                                KEPT_VIEWS_LEFT_FILE);
+    rightCalibrator.saveSingleCalibrationResults(INTRINSIC_MATRIX_RIGHT_FILE,
+                                                 DISTORTION_COEFFS_RIGHT_FILE,
+                                                 KEPT_VIEWS_RIGHT_FILE);
 }
 
 void StereoCalibrator::calibrateCameras() noexcept
@@ -368,7 +595,7 @@ void StereoCalibrator::calibrateCameras() noexcept
     cv::Mat essentialMatrix(3, 3, CV_32FC1), fundamentalMatrix(3, 3, CV_32FC1);
 
     double error = cv::stereoCalibrate(
-        _objectPoints, _points[LEFT], _points[RIGHT],
+        _objectPoints.views(), _points[LEFT].views(), _points[RIGHT].views(),
         _calibrationData.intrinsic(LEFT), _calibrationData.distortion(LEFT),
         _calibrationData.intrinsic(RIGHT), _calibrationData.distortion(RIGHT),
         _image -> size(), stereoRotation, stereoTranslation,
@@ -407,7 +634,7 @@ double StereoCalibrator::computeAverageCalibrationError() noexcept
     vector<cv::Point3f> lines[2];
 
     double avgErr = undistortAndComputeEpilines(lines);
-    int totalPointsAmount = _calibrationData.imagesAmount() *
+    int totalPointsAmount = _points[LEFT].viewsAmount() *
                             _calibrationData.pointsOnBoardAmount();
     return avgErr / totalPointsAmount;
 }
@@ -416,24 +643,27 @@ double StereoCalibrator::undistortAndComputeEpilines(vector<cv::Point3f> lines[]
         noexcept
 {
     double avgErr = 0;
-    for (int i = 0; i < _calibrationData.imagesAmount(); i++ )
+    for (size_t i = 0; i < _points[LEFT].viewsAmount(); i++ )
     {
-        cv::undistortPoints(_points[LEFT][i],
-                            _points[LEFT][i],
+        cv::Mat leftPoints  = _points[LEFT].view(i);
+        cv::Mat rightPoints = _points[RIGHT].view(i);
+
+        cv::undistortPoints(leftPoints,
+                            leftPoints,
                             _calibrationData.intrinsic(LEFT),
                             _calibrationData.distortion(LEFT),
                             cv::noArray(),
                             _calibrationData.intrinsic(LEFT));
-        cv::undistortPoints(_points[RIGHT][i],
-                            _points[RIGHT][i],
+        cv::undistortPoints(rightPoints,
+                            rightPoints,
                             _calibrationData.intrinsic(RIGHT),
                             _calibrationData.distortion(RIGHT),
                             cv::noArray(),
                             _calibrationData.intrinsic(RIGHT));
-        cv::computeCorrespondEpilines(_points[LEFT][i], 1,
+        cv::computeCorrespondEpilines(leftPoints, 1,
                                       _calibrationData.fundamentalMatrix(),
                                       lines[LEFT]);
-        cv::computeCorrespondEpilines(_points[RIGHT][i], 2,
+        cv::computeCorrespondEpilines(rightPoints, 2,
                                       _calibrationData.fundamentalMatrix(),
                                       lines[RIGHT]);
         avgErr += computeErrorForImagePair(lines, i);
@@ -445,12 +675,14 @@ double StereoCalibrator::computeErrorForImagePair(vector<cv::Point3f> lines[],
                                                   int index) noexcept
 {
     double err = 0;
+    const cv::Point2f* leftPoints  = _points[LEFT].points(index);
+    const cv::Point2f* rightPoints = _points[RIGHT].points(index);
     for (unsigned j = 0; j < _calibrationData.pointsOnBoardAmount(); j++)
     {
-        err += std::abs(_points[LEFT][index][j].x*lines[RIGHT][j].x +
-               _points[LEFT][index][j].y*lines[RIGHT][j].y + lines[RIGHT][j].z)
-               + std::abs(_points[RIGHT][index][j].x*lines[LEFT][j].x +
-               _points[RIGHT][index][j].y*lines[LEFT][j].y + lines[LEFT][j].z);
+        err += std::abs(leftPoints[j].x*lines[RIGHT][j].x +
+               leftPoints[j].y*lines[RIGHT][j].y + lines[RIGHT][j].z)
+               + std::abs(rightPoints[j].x*lines[LEFT][j].x +
+               rightPoints[j].y*lines[LEFT][j].y + lines[LEFT][j].z);
     }
     return err;
 }
@@ -5,6 +5,7 @@
 #include "DisplayManager.h"
 #include "CommonExceptions.h"
 #include "Calibrator.h"
+#include "RectifyMapGenerator.h"
 
 #include <opencv2/highgui/highgui.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
@@ -14,6 +15,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <future>
 
 using std::vector;
 using MatSharedPtr = std::shared_ptr<cv::Mat>;
@@ -26,35 +28,28 @@ public:
                      int boardWidth,
                      int boardHeight) throw (FramesAmountMatchError);
 
-    void execute() noexcept;
+    bool execute() noexcept;
+    bool executeEndToEnd() noexcept;
 
     void useBouguetsMethod() noexcept;
     void useHartleyMethod() noexcept;
+    void useRectifyMapsCache(const std::string& cacheDirectory) noexcept;
 
-private:
-    cv::Mat createPairImage(const cv::Mat& leftImage,
-                            const cv::Mat& rightImage,
-                            const cv::Size& size) const noexcept;
-
-    cv::Mat columnRange(const cv::Mat& image,
-                        const int startColumn,
-                        const int endColumn) const noexcept;
-
-    cv::Mat remapImage(const cv::Mat& image,
-                       const cv::Mat& rectifyMapX1,
-                       const cv::Mat& rectifyMapY1) const noexcept;
-    cv::Mat resizeImage(const cv::Mat& image) const noexcept;
-    cv::Mat convertToBGRImage(const cv::Mat& grayImage,
-                              const cv::Size& newImageSize) const noexcept;
+    const StereoCalibrationData& stereoCalibrationData() const noexcept
+    { return _calibrationData; }
+    RectifyMaps rectifyMaps() const noexcept;
 
-    cv::Mat createImageWithHorizontalLines(const cv::Mat& image) const noexcept;
+    void addRectificationProfile(const std::string& name, double scale)
+        noexcept;
+    const RectificationProfile* rectificationProfile(
+            const std::string& name) const noexcept;
 
-    cv::Mat captureLeftGrayImage() noexcept;
-    cv::Mat captureRightGrayImage()  noexcept;
+private:
+    void initPreviewMapsAndImage() noexcept;
+    cv::Mat scaledCameraMatrix(const cv::Mat& cameraMatrix) const noexcept;
 
-    void prepareAndDisplayPairImage(const cv::Mat& firstGrayImage,
-                                    const cv::Mat& secondGrayImage)
-        const noexcept;
+    void prepareAndDisplayPairImage() noexcept;
+    void drawHorizontalLines(cv::Mat& image) const noexcept;
 
     void initIntrinsicsAndDistortions() noexcept;
 
@@ -64,9 +59,16 @@ private:
                                       const std::string distortionR) noexcept;
     void saveCalibrationResults() const noexcept;
 
-    void chooseNextImage(const int leftOrRight) noexcept;
+    void chooseNextImage(const int leftOrRight) throw (ImageReadError);
+    void keepCommonViews() noexcept;
+    bool hasEnoughViews() const noexcept;
 
-    void findAllCorners() noexcept;
+    void findAllCorners() throw (InterruptedByUser);
+    void findAllCornersOnce(CornerStore monoPoints[])
+        throw (InterruptedByUser);
+    void calibrateMonoCamerasConcurrently(const CornerStore monoPoints[])
+        noexcept;
+    void calibrateAndRectify() noexcept;
 
     void calibrateCameras() noexcept;
 
@@ -74,13 +76,22 @@ private:
 
     void precomputeMapForRemap(const cv::Mat& cameraMatrix1,
                                const cv::Mat& cameraMatrix2) noexcept;
-    void initializeAllImagesPoint();
     void bouguetsMethod();
     void hartleysMethod();
     void computeRectification() noexcept;
 
     void saveRectifyMaps() const noexcept;
 
+    void computeRectificationProfiles() noexcept;
+    void computeRectificationProfile(RectificationProfile& profile) noexcept;
+    void saveRectificationProfile(const RectificationProfile& profile)
+        const noexcept;
+    cv::Mat pixelScaleMatrix(double scale) const noexcept;
+    cv::Mat scaledProjectionMatrix(const cv::Mat& projectionMatrix,
+                                   double scale) const noexcept;
+    cv::Mat scaledD2DMappingMatrix(const cv::Mat& d2DMappingMatrix,
+                                   double scale) const noexcept;
+
     double computeAverageCalibrationError() noexcept;
     double undistortAndComputeEpilines(vector<cv::Point3f> lines[]) noexcept;
     double computeErrorForImagePair(vector<cv::Point3f> lines[],
@@ -94,12 +105,13 @@ private:
 
     std::string _imagesLeft;
     std::string _imagesRight;
-    cv::VideoCapture _captureLeft;
-    cv::VideoCapture _captureRight;
+    FrameSource _captureLeft;
+    FrameSource _captureRight;
     StereoCalibrationData _calibrationData;
+    RectifyMapGenerator _rectifyMapGenerator;
+    vector<RectificationProfile> _rectificationProfiles;
 
-    vector<vector<cv::Point2f>> _points[2];
-    vector<cv::Point2f> _allImagesPoints[2];
+    CornerStore _points[2];
 
     MatSharedPtr _rectifyMapX1;
     MatSharedPtr _rectifyMapY1;
@@ -108,13 +120,29 @@ private:
     MatSharedPtr _remappedImage1;
     MatSharedPtr _remappedImage2;
 
+    cv::Mat _newCameraMatrix1;
+    cv::Mat _newCameraMatrix2;
+    Undistorter _previewUndistorterLeft;
+    Undistorter _previewUndistorterRight;
+    cv::Mat _leftFrame;
+    cv::Mat _rightFrame;
+    MatSharedPtr _pairImage;
+
     const int LEFT  = 0;
     const int RIGHT = 1;
 
     const float RESIZE_FACTOR = 0.625;
+    const int PAIR_IMAGE_SHOWING_TIME = 5000;
 
     const std::string CORNERS_WINDOW_TITLE = "Corners";
 
+    const std::string INTRINSIC_MATRIX_LEFT_FILE = "intrinsic_matrixL.yml";
+    const std::string DISTORTION_COEFFS_LEFT_FILE = "distortion_coeffsL.yml";
+    const std::string KEPT_VIEWS_LEFT_FILE = "kept_viewsL.yml";
+    const std::string INTRINSIC_MATRIX_RIGHT_FILE = "intrinsic_matrixR.yml";
+    const std::string DISTORTION_COEFFS_RIGHT_FILE = "distortion_coeffsR.yml";
+    const std::string KEPT_VIEWS_RIGHT_FILE = "kept_viewsR.yml";
+
     const std::string STEREO_ROTATION_OUTPUT_FILE = "stereo_rotation.yml";
     const std::string STEREO_TRANSLATION_OUTPUT_FILE = "stereo_translation.yml";
     const std::string ESSENTIAL_MATRIX_OUTPUT_FILE = "essential_matrix.yml";
@@ -123,6 +151,11 @@ private:
     const std::string PROJECTION_MATRICES_OUTPUT_FILE = "projection_matrices.yml";
     const std::string D2D_MAPPING_MATRIX_OUTPUT_FILE = "d2d_mapping_matrix.yml";
     const std::string RECTIFY_MAPS_OUTPUT_FILE = "rectify_maps.yml";
+    const std::string PROFILE_RECTIFY_MAPS_PREFIX = "rectify_maps_";
+    const std::string PROFILE_PROJECTION_MATRICES_PREFIX =
+        "projection_matrices_";
+    const std::string PROFILE_D2D_MAPPING_MATRIX_PREFIX = "d2d_mapping_matrix_";
+    const std::string YML_EXTENSION = ".yml";
 
     const std::string RECTIFY_MAP_X1_TITLE = "Rectify Map X1";
     const std::string RECTIFY_MAP_Y1_TITLE = "Rectify Map Y1";
@@ -130,6 +163,9 @@ private:
     const std::string RECTIFY_MAP_Y2_TITLE = "Rectify Map Y2";
 
     const std::string RUNNING_CALIBRATION = "Running stereo calibration ...";
+    const std::string END_OF_STREAM = "End of image stream, pairs read: ";
+    const std::string NOT_ENOUGH_VIEWS =
+        "Not enough stereo views to calibrate";
     const std::string CALIBRATION_DONE = " done";
 };
 
@@ -0,0 +1,48 @@
+#ifndef STEREOMATCHERBACKEND_H
+#define STEREOMATCHERBACKEND_H
+
+#include "StereoMatcherParameters.h"
+
+#include <opencv2/core/core.hpp>
+
+#include <string>
+#include <memory>
+
+class StereoMatcherBackend
+{
+public:
+    virtual ~StereoMatcherBackend() noexcept {}
+
+    virtual void compute(const cv::Mat& leftImage,
+                         const cv::Mat& rightImage,
+                         cv::Mat& disparity) noexcept = 0;
+
+    virtual void computeWithUniqueness(const cv::Mat& leftImage,
+                                       const cv::Mat& rightImage,
+                                       cv::Mat& disparity,
+                                       cv::Mat& uniqueness) noexcept
+    {
+        compute(leftImage, rightImage, disparity);
+        uniqueness.release();
+    }
+
+    virtual std::string name() const noexcept = 0;
+
+    virtual bool clampParameters() noexcept { return false; }
+
+    StereoMatcherParameters& parameters() noexcept { return _parameters; }
+    const StereoMatcherParameters& parameters() const noexcept
+    { return _parameters; }
+
+    void saveParameters(cv::FileStorage& fileStorage) const noexcept
+    { _parameters.save(fileStorage, name()); }
+    void loadParameters(const cv::FileStorage& fileStorage) noexcept
+    { _parameters.load(fileStorage, name()); clampParameters(); }
+
+protected:
+    StereoMatcherParameters _parameters;
+};
+
+using StereoMatcherBackendPtr = std::shared_ptr<StereoMatcherBackend>;
+
+#endif // STEREOMATCHERBACKEND_H
@@ -0,0 +1,51 @@
+#include "StereoMatcherBenchmark.h"
+
+StereoMatcherBenchmark::StereoMatcherBenchmark(
+        const vector<StereoMatcherBackendPtr>& backends) noexcept
+    : _backends(backends)
+{
+}
+
+void StereoMatcherBenchmark::run(const vector<cv::Mat>& leftImages,
+                                 const vector<cv::Mat>& rightImages)
+    const noexcept
+{
+    if(leftImages.empty()) return;
+
+    cv::Mat disparity;
+    for(auto& backend : _backends)
+    {
+        double totalLatency = 0, totalDensity = 0;
+
+        for(size_t i = 0; i < leftImages.size(); i++)
+        {
+            int64 start = cv::getTickCount();
+            backend->compute(leftImages[i], rightImages[i], disparity);
+            totalLatency += (cv::getTickCount() - start) * 1000.0 /
+                            cv::getTickFrequency();
+            totalDensity += validPixelsDensity(
+                                disparity, backend->parameters().minDisparity);
+        }
+        showResults(backend->name(),
+                    totalLatency / leftImages.size(),
+                    totalDensity / leftImages.size());
+    }
+}
+
+double StereoMatcherBenchmark::validPixelsDensity(const cv::Mat& disparity,
+                                                  int minDisparity)
+    const noexcept
+{
+    cv::Mat validPixels = disparity >= minDisparity * DISPARITY_SCALE;
+    return static_cast<double>(cv::countNonZero(validPixels)) /
+           disparity.total();
+}
+
+void StereoMatcherBenchmark::showResults(const std::string& backendName,
+                                         double averageLatency,
+                                         double averageDensity) const noexcept
+{
+    std::cout << backendName << ": "
+              << "latency " << averageLatency << " ms, "
+              << "valid pixels " << averageDensity * 100 << "%" << std::endl;
+}
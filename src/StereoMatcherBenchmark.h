@@ -0,0 +1,37 @@
+#ifndef STEREOMATCHERBENCHMARK_H
+#define STEREOMATCHERBENCHMARK_H
+
+#include "StereoMatcherBackend.h"
+
+#include <opencv2/core/core.hpp>
+
+#include <iostream>
+#include <vector>
+
+using std::vector;
+
+class StereoMatcherBenchmark
+{
+public:
+    StereoMatcherBenchmark(const vector<StereoMatcherBackendPtr>& backends)
+        noexcept;
+
+    void run(const vector<cv::Mat>& leftImages,
+             const vector<cv::Mat>& rightImages) const noexcept;
+
+private:
+    double validPixelsDensity(const cv::Mat& disparity,
+                              int minDisparity) const noexcept;
+
+    void showResults(const std::string& backendName,
+                     double averageLatency,
+                     double averageDensity) const noexcept;
+
+
+
+    vector<StereoMatcherBackendPtr> _backends;
+
+    const int DISPARITY_SCALE = 16;
+};
+
+#endif // STEREOMATCHERBENCHMARK_H
@@ -0,0 +1,40 @@
+#include "StereoMatcherParameters.h"
+
+void StereoMatcherParameters::save(cv::FileStorage& fileStorage,
+                                   const std::string& title) const noexcept
+{
+    fileStorage << title << "{";
+    fileStorage << "minDisparity" << minDisparity;
+    fileStorage << "numberOfDisparities" << numberOfDisparities;
+    fileStorage << "blockSize" << blockSize;
+    fileStorage << "disp12MaxDiff" << disp12MaxDiff;
+    fileStorage << "preFilterCap" << preFilterCap;
+    fileStorage << "preFilterSize" << preFilterSize;
+    fileStorage << "textureThreshold" << textureThreshold;
+    fileStorage << "uniquenessRatio" << uniquenessRatio;
+    fileStorage << "speckleWindowSize" << speckleWindowSize;
+    fileStorage << "speckleRange" << speckleRange;
+    fileStorage << "smoothnessPar1" << smoothnessPar1;
+    fileStorage << "smoothnessPar2" << smoothnessPar2;
+    fileStorage << "}";
+}
+
+void StereoMatcherParameters::load(const cv::FileStorage& fileStorage,
+                                   const std::string& title) noexcept
+{
+    cv::FileNode node = fileStorage[title];
+    if(node.empty()) return;
+
+    node["minDisparity"] >> minDisparity;
+    node["numberOfDisparities"] >> numberOfDisparities;
+    node["blockSize"] >> blockSize;
+    node["disp12MaxDiff"] >> disp12MaxDiff;
+    node["preFilterCap"] >> preFilterCap;
+    node["preFilterSize"] >> preFilterSize;
+    node["textureThreshold"] >> textureThreshold;
+    node["uniquenessRatio"] >> uniquenessRatio;
+    node["speckleWindowSize"] >> speckleWindowSize;
+    node["speckleRange"] >> speckleRange;
+    node["smoothnessPar1"] >> smoothnessPar1;
+    node["smoothnessPar2"] >> smoothnessPar2;
+}
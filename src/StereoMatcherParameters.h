@@ -0,0 +1,29 @@
+#ifndef STEREOMATCHERPARAMETERS_H
+#define STEREOMATCHERPARAMETERS_H
+
+#include <opencv2/core/core.hpp>
+
+#include <string>
+
+struct StereoMatcherParameters
+{
+    void save(cv::FileStorage& fileStorage, const std::string& title)
+        const noexcept;
+    void load(const cv::FileStorage& fileStorage, const std::string& title)
+        noexcept;
+
+    int minDisparity        = 0;
+    int numberOfDisparities = 768;
+    int blockSize           = 9;
+    int disp12MaxDiff       = 1;
+    int preFilterCap        = 0;
+    int preFilterSize       = 9;
+    int textureThreshold    = 0;
+    int uniquenessRatio     = 0;
+    int speckleWindowSize   = 0;
+    int speckleRange        = 0;
+    int smoothnessPar1      = 200;
+    int smoothnessPar2      = 255;
+};
+
+#endif // STEREOMATCHERPARAMETERS_H
@@ -0,0 +1,108 @@
+#include "StereoPipeline.h"
+
+StereoPipeline::StereoPipeline(const StereoCalibrationData& calibrationData,
+                               const RectifyMaps& rectifyMaps) noexcept
+    : _calibrationData(calibrationData),
+      _disparityProvider(rectifyMaps),
+      _pointCloudGenerator(cv::Mat(), calibrationData.d2DMappingMatrix())
+{
+    _disparityProvider.enableConfidenceMap();
+}
+
+StereoPipeline::StereoPipeline(const StereoCalibrator& stereoCalibrator)
+    noexcept
+    : StereoPipeline(stereoCalibrator.stereoCalibrationData(),
+                     stereoCalibrator.rectifyMaps())
+{
+}
+
+StereoPipeline::StereoPipeline(const StereoCalibrator& stereoCalibrator,
+                               const std::string& profileName) noexcept
+    : StereoPipeline(profileCalibrationData(stereoCalibrator, profileName),
+                     profileRectifyMaps(stereoCalibrator, profileName))
+{
+}
+
+const cv::Mat& StereoPipeline::process(const cv::Mat& leftImage,
+                                       const cv::Mat& rightImage) noexcept
+{
+    const cv::Mat& disparity =
+        _disparityProvider.computeDisparityMap(leftImage, rightImage);
+
+    disparity.convertTo(_disparityMap, CV_32F, 1.0 / DISPARITY_SCALE);
+    _pointCloudGenerator.setDisparityMap(_disparityMap);
+    _pointCloudGenerator.setConfidenceMap(_disparityProvider.confidenceMap(),
+                                          _confidenceThreshold);
+    _points = _pointCloudGenerator.computePoints();
+    if(!_sharedMemoryName.empty()) publishPoints();
+    return _points;
+}
+
+void StereoPipeline::startPublishingPoints(const std::string& sharedMemoryName)
+    noexcept
+{
+    _pointsPublisher.reset();
+    _sharedMemoryName = sharedMemoryName;
+}
+
+void StereoPipeline::stopPublishingPoints() noexcept
+{
+    _pointsPublisher.reset();
+    _sharedMemoryName.clear();
+}
+
+void StereoPipeline::publishPoints() noexcept
+{
+    if(!_pointsPublisher)
+        _pointsPublisher.reset(new SharedFramePublisher(
+            _sharedMemoryName, _points.total() * _points.elemSize()));
+
+    if(!_pointsPublisher->publish(_points))
+    {
+        std::cerr << PUBLISHING_FAILED << _sharedMemoryName << std::endl;
+        stopPublishingPoints();
+    }
+}
+
+void StereoPipeline::setConfidenceThreshold(int confidenceThreshold) noexcept
+{
+    _confidenceThreshold = confidenceThreshold;
+}
+
+void StereoPipeline::useLeftRightCheck(bool leftRightCheck) noexcept
+{
+    _disparityProvider.enableConfidenceMap(leftRightCheck);
+}
+
+StereoCalibrationData StereoPipeline::profileCalibrationData(
+        const StereoCalibrator& stereoCalibrator,
+        const std::string& profileName) noexcept
+{
+    StereoCalibrationData calibrationData =
+        stereoCalibrator.stereoCalibrationData();
+    const RectificationProfile* profile =
+        stereoCalibrator.rectificationProfile(profileName);
+
+    if(!profile) return calibrationData;
+
+    calibrationData.setProjectionMatrices(profile->projectionMatrix1,
+                                          profile->projectionMatrix2);
+    if(!profile->d2DMappingMatrix.empty())
+        calibrationData.setD2DMappingMatrix(profile->d2DMappingMatrix);
+    return calibrationData;
+}
+
+RectifyMaps StereoPipeline::profileRectifyMaps(
+        const StereoCalibrator& stereoCalibrator,
+        const std::string& profileName) noexcept
+{
+    const RectificationProfile* profile =
+        stereoCalibrator.rectificationProfile(profileName);
+
+    return profile ? profile->maps : stereoCalibrator.rectifyMaps();
+}
+
+void StereoPipeline::savePointsWithPlyExtension() noexcept
+{
+    _pointCloudGenerator.savePointsWithPlyExtension();
+}
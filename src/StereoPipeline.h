@@ -0,0 +1,77 @@
+#ifndef STEREOPIPELINE_H
+#define STEREOPIPELINE_H
+
+#include "StereoCalibrator.h"
+#include "StereoCalibrationData.h"
+#include "RectifyMapGenerator.h"
+#include "DisparityProvider.h"
+#include "PointCloudGenerator.h"
+#include "SharedFramePublisher.h"
+
+#include <opencv2/core/core.hpp>
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+class StereoPipeline
+{
+public:
+    StereoPipeline(const StereoCalibrationData& calibrationData,
+                   const RectifyMaps& rectifyMaps) noexcept;
+    StereoPipeline(const StereoCalibrator& stereoCalibrator) noexcept;
+    StereoPipeline(const StereoCalibrator& stereoCalibrator,
+                   const std::string& profileName) noexcept;
+
+    const cv::Mat& process(const cv::Mat& leftImage,
+                           const cv::Mat& rightImage) noexcept;
+
+    const cv::Mat& disparityMap() const noexcept { return _disparityMap; }
+    const cv::Mat& points() const noexcept { return _points; }
+
+    DisparityProvider& disparityProvider() noexcept
+    { return _disparityProvider; }
+    const StereoCalibrationData& calibrationData() const noexcept
+    { return _calibrationData; }
+
+    void savePointsWithPlyExtension() noexcept;
+
+    void setConfidenceThreshold(int confidenceThreshold) noexcept;
+    void useLeftRightCheck(bool leftRightCheck) noexcept;
+
+    void startPublishingPoints(const std::string& sharedMemoryName) noexcept;
+    void stopPublishingPoints() noexcept;
+    const cv::Mat& confidenceMap() const noexcept
+    { return _disparityProvider.confidenceMap(); }
+
+private:
+    void publishPoints() noexcept;
+
+    static StereoCalibrationData profileCalibrationData(
+            const StereoCalibrator& stereoCalibrator,
+            const std::string& profileName) noexcept;
+    static RectifyMaps profileRectifyMaps(
+            const StereoCalibrator& stereoCalibrator,
+            const std::string& profileName) noexcept;
+
+    StereoCalibrationData _calibrationData;
+    DisparityProvider _disparityProvider;
+    PointCloudGenerator _pointCloudGenerator;
+
+    cv::Mat _disparityMap;
+    cv::Mat _points;
+
+    std::string _sharedMemoryName;
+    std::unique_ptr<SharedFramePublisher> _pointsPublisher;
+
+    int _confidenceThreshold = DEFAULT_CONFIDENCE_THRESHOLD;
+
+    static const int DEFAULT_CONFIDENCE_THRESHOLD = 64;
+
+    const double DISPARITY_SCALE = 16;
+
+    const std::string PUBLISHING_FAILED =
+        "Stopped publishing points, shared memory ring unusable: ";
+};
+
+#endif // STEREOPIPELINE_H
@@ -0,0 +1,138 @@
+#include "Undistorter.h"
+
+#include <algorithm>
+
+constexpr double Undistorter::NO_ALPHA;
+
+class RowBandRemapper : public cv::ParallelLoopBody
+{
+public:
+    RowBandRemapper(const cv::Mat& image,
+                    const cv::Mat& map1,
+                    const cv::Mat& map2,
+                    cv::Mat& output,
+                    int bandHeight) noexcept
+        : _image(image),
+          _map1(map1),
+          _map2(map2),
+          _output(output),
+          _bandHeight(bandHeight)
+    {
+    }
+
+    void operator()(const cv::Range& range) const
+    {
+        for(int band = range.start; band < range.end; band++)
+        {
+            int firstRow = band * _bandHeight;
+            int lastRow  = std::min(firstRow + _bandHeight, _output.rows);
+            cv::Mat outputBand = _output.rowRange(firstRow, lastRow);
+
+            cv::remap(_image, outputBand,
+                      _map1.rowRange(firstRow, lastRow),
+                      _map2.rowRange(firstRow, lastRow),
+                      cv::INTER_LINEAR, cv::BORDER_CONSTANT);
+        }
+    }
+
+private:
+    const cv::Mat& _image;
+    const cv::Mat& _map1;
+    const cv::Mat& _map2;
+    cv::Mat& _output;
+    const int _bandHeight;
+};
+
+Undistorter::Undistorter(const cv::Mat& intrinsic,
+                         const cv::Mat& distortion,
+                         const cv::Size& imageSize,
+                         double alpha,
+                         double scale) noexcept
+{
+    initMaps(intrinsic, distortion, imageSize, alpha, scale);
+}
+
+Undistorter::Undistorter(const CalibrationData& calibrationData,
+                         int camera,
+                         const cv::Size& imageSize,
+                         double alpha,
+                         double scale) noexcept
+{
+    initMaps(calibrationData.intrinsic(camera),
+             calibrationData.distortion(camera),
+             imageSize, alpha, scale);
+}
+
+Undistorter::Undistorter(const cv::Mat& mapX, const cv::Mat& mapY) noexcept
+    : _validRegion(0, 0, mapX.cols, mapX.rows)
+{
+    cv::convertMaps(mapX, mapY, _map1, _map2, CV_16SC2);
+}
+
+const cv::Mat& Undistorter::apply(const cv::Mat& image) noexcept
+{
+    apply(image, _output);
+
+    if(!_cropToValidRegion || _validRegion.area() == 0) return _output;
+    _croppedOutput = _output(_validRegion);
+    return _croppedOutput;
+}
+
+void Undistorter::apply(const cv::Mat& image, cv::Mat& output) const noexcept
+{
+    output.create(_map1.size(), image.type());
+
+    int bandsAmount = (output.rows + BAND_HEIGHT - 1) / BAND_HEIGHT;
+    cv::parallel_for_(cv::Range(0, bandsAmount),
+                      RowBandRemapper(image, _map1, _map2, output, BAND_HEIGHT));
+}
+
+void Undistorter::setCropToValidRegion(bool cropToValidRegion) noexcept
+{
+    _cropToValidRegion = cropToValidRegion;
+}
+
+bool Undistorter::isReady() const noexcept
+{
+    return !_map1.empty();
+}
+
+cv::Size Undistorter::outputSize() const noexcept
+{
+    return _map1.size();
+}
+
+const cv::Rect& Undistorter::validRegion() const noexcept
+{
+    return _validRegion;
+}
+
+const cv::Mat& Undistorter::newCameraMatrix() const noexcept
+{
+    return _newCameraMatrix;
+}
+
+void Undistorter::initMaps(const cv::Mat& intrinsic,
+                           const cv::Mat& distortion,
+                           const cv::Size& imageSize,
+                           double alpha,
+                           double scale) noexcept
+{
+    cv::Size outputSize(cvRound(imageSize.width * scale),
+                        cvRound(imageSize.height * scale));
+
+    if(alpha < 0)
+    {
+        intrinsic.convertTo(_newCameraMatrix, CV_64F);
+        cv::Mat imageRows = _newCameraMatrix.rowRange(0, 2);
+        imageRows.convertTo(imageRows, -1, scale);
+        _validRegion = cv::Rect(0, 0, outputSize.width, outputSize.height);
+    }
+    else
+        _newCameraMatrix = cv::getOptimalNewCameraMatrix(
+            intrinsic, distortion, imageSize, alpha, outputSize, &_validRegion);
+
+    cv::initUndistortRectifyMap(intrinsic, distortion, cv::Mat(),
+                                _newCameraMatrix, outputSize,
+                                CV_16SC2, _map1, _map2);
+}
@@ -0,0 +1,59 @@
+#ifndef UNDISTORTER_H
+#define UNDISTORTER_H
+
+#include "CalibrationData.h"
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+#include <opencv2/calib3d/calib3d.hpp>
+
+class Undistorter
+{
+public:
+    Undistorter() noexcept {}
+    Undistorter(const cv::Mat& intrinsic,
+                const cv::Mat& distortion,
+                const cv::Size& imageSize,
+                double alpha = NO_ALPHA,
+                double scale = 1) noexcept;
+    Undistorter(const CalibrationData& calibrationData,
+                int camera,
+                const cv::Size& imageSize,
+                double alpha = NO_ALPHA,
+                double scale = 1) noexcept;
+    Undistorter(const cv::Mat& mapX, const cv::Mat& mapY) noexcept;
+
+    const cv::Mat& apply(const cv::Mat& image) noexcept;
+    void apply(const cv::Mat& image, cv::Mat& output) const noexcept;
+
+    void setCropToValidRegion(bool cropToValidRegion) noexcept;
+
+    bool isReady() const noexcept;
+    cv::Size outputSize() const noexcept;
+    const cv::Rect& validRegion() const noexcept;
+    const cv::Mat& newCameraMatrix() const noexcept;
+
+    static constexpr double NO_ALPHA = -1;
+
+private:
+    void initMaps(const cv::Mat& intrinsic,
+                  const cv::Mat& distortion,
+                  const cv::Size& imageSize,
+                  double alpha,
+                  double scale) noexcept;
+
+
+
+    cv::Mat _map1;
+    cv::Mat _map2;
+    cv::Mat _newCameraMatrix;
+    cv::Rect _validRegion;
+    cv::Mat _output;
+    cv::Mat _croppedOutput;
+
+    bool _cropToValidRegion = false;
+
+    static const int BAND_HEIGHT = 32;
+};
+
+#endif // UNDISTORTER_H
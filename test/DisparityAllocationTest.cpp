@@ -0,0 +1,91 @@
+// Runs the in-memory disparity loop on synthetic frames and counts heap
+// allocations per frame once warm-up is over. The check covers the Census
+// backend, which must not allocate at all; rectification goes through
+// cv::remap, so its allocations are counted too. The default SGBM backend
+// allocates inside OpenCV (its in-place median filter copies the image),
+// so its count is only reported, not required to be zero. Build it
+// together with the sources under src/, with the counting hook enabled:
+//
+//   g++ -std=c++11 -O2 -DCOUNT_ALLOCATIONS -Isrc
+//       test/DisparityAllocationTest.cpp src/*.cpp
+//       `pkg-config --cflags --libs opencv` -pthread
+
+#include "DisparityProvider.h"
+#include "AllocationCounter.h"
+
+#include <iostream>
+#include <algorithm>
+
+const int FRAMES_AMOUNT  = 20;
+const int WARM_UP_FRAMES = 3;
+const int IMAGE_WIDTH    = 320;
+const int IMAGE_HEIGHT   = 240;
+const int IMAGE_SHIFT    = 8;
+
+RectifyMaps createRectifyMaps(const cv::Size& imageSize)
+{
+    RectifyMaps maps;
+    cv::Mat mapX(imageSize, CV_32F), mapY(imageSize, CV_32F);
+
+    for(int y = 0; y < imageSize.height; y++)
+        for(int x = 0; x < imageSize.width; x++)
+        {
+            mapX.at<float>(y, x) = x + 0.25f;
+            mapY.at<float>(y, x) = y + 0.5f;
+        }
+
+    maps.leftX  = mapX;
+    maps.leftY  = mapY;
+    maps.rightX = mapX.clone();
+    maps.rightY = mapY.clone();
+    return maps;
+}
+
+int warmedUpAllocations(DisparityProvider& provider,
+                        const cv::Mat& leftImage,
+                        const cv::Mat& rightImage)
+{
+    int allocations = 0;
+
+    provider.setAllocationCheck(WARM_UP_FRAMES);
+    for(int frame = 0; frame < FRAMES_AMOUNT; frame++)
+    {
+        provider.computeDisparityMap(leftImage, rightImage);
+        if(frame >= WARM_UP_FRAMES)
+            allocations = std::max(allocations,
+                                   provider.lastFrameAllocations());
+    }
+    return allocations;
+}
+
+int main()
+{
+    if(!AllocationCounter::isEnabled())
+    {
+        std::cerr << "Build with -DCOUNT_ALLOCATIONS" << std::endl;
+        return 1;
+    }
+
+    const cv::Size imageSize(IMAGE_WIDTH, IMAGE_HEIGHT);
+    cv::Mat leftImage(imageSize, CV_8UC3), rightImage(imageSize, CV_8UC3);
+    cv::RNG randomGenerator(49);
+
+    randomGenerator.fill(leftImage, cv::RNG::UNIFORM, 0, 256);
+    rightImage.setTo(cv::Scalar::all(0));
+    leftImage.colRange(IMAGE_SHIFT, IMAGE_WIDTH)
+             .copyTo(rightImage.colRange(0, IMAGE_WIDTH - IMAGE_SHIFT));
+
+    DisparityProvider provider(createRectifyMaps(imageSize));
+
+    provider.useSGBMBackend();
+    std::cout << "SGBM allocations per warmed-up frame (not checked): "
+              << warmedUpAllocations(provider, leftImage, rightImage)
+              << std::endl;
+
+    provider.useCensusBackend();
+    int censusAllocations = warmedUpAllocations(provider,
+                                                leftImage, rightImage);
+    std::cout << "Census allocations per warmed-up frame: "
+              << censusAllocations << std::endl;
+    return censusAllocations == 0 ? 0 : 1;
+}